@@ -0,0 +1,47 @@
+#ifndef SRC_BENCHMARKS_BENCH_H
+#define SRC_BENCHMARKS_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace s21_bench {
+// Element count taken from the first command line argument, so the same
+// binary covers quick smoke runs and 10M-element measurements.
+inline std::size_t SizeFromArgs(int argc, char **argv, std::size_t fallback) {
+  if (argc < 2) return fallback;
+  return static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+}
+
+inline std::vector<int> ShuffledKeys(std::size_t n, unsigned seed = 21) {
+  std::vector<int> keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+  return keys;
+}
+
+template <typename F>
+double NsPerOp(std::size_t ops, F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  return ops ? ns / static_cast<double>(ops) : 0.0;
+}
+
+inline void Report(const char *name, std::size_t n, double ns_per_op) {
+  std::printf("%-40s n=%-10zu %10.1f ns/op\n", name, n, ns_per_op);
+}
+
+// Keeps the optimizer from discarding benchmark results.
+template <typename T>
+void DoNotOptimize(const T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+}  // namespace s21_bench
+
+#endif  // SRC_BENCHMARKS_BENCH_H
@@ -0,0 +1,69 @@
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "../s21_set_algebra.h"
+#include "bench.h"
+
+namespace {
+using IdSet = s21::set<std::uint64_t>;
+
+// Every other id of a shuffled range, so the two sets overlap by about
+// half of the smaller one.
+IdSet MakeIds(std::size_t n, unsigned seed) {
+  IdSet ids;
+  for (int key : s21_bench::ShuffledKeys(2 * n, seed)) {
+    if (key % 2 == 0 || ids.size() < n / 2) ids.insert(key);
+    if (ids.size() == n) break;
+  }
+  return ids;
+}
+
+// The approach being replaced: a lookup in the larger set per element of
+// the smaller one, O(m log n).
+IdSet IntersectByFind(const IdSet &small, IdSet &large) {
+  IdSet result;
+  for (std::uint64_t id : small) {
+    if (large.contains(id)) result.insert(id);
+  }
+  return result;
+}
+
+void Compare(const char *shape, std::size_t n, std::size_t m) {
+  IdSet large = MakeIds(n, 21);
+  IdSet small = MakeIds(m, 7);
+  unsigned hardware = std::thread::hardware_concurrency();
+  std::string prefix = std::string(shape) + " ";
+  // Intersections are timed per element of the smaller set, which is all
+  // a galloping merge needs to visit; union and difference per element of
+  // both, since they copy the larger set.
+  auto run = [&](const char *label, std::size_t ops, auto &&op) {
+    double ns = s21_bench::NsPerOp(ops, [&] {
+      IdSet result = op();
+      s21_bench::DoNotOptimize(result);
+    });
+    s21_bench::Report((prefix + label).c_str(), ops, ns);
+  };
+  run("intersection by find", m,
+      [&] { return IntersectByFind(small, large); });
+  run("intersection serial", m,
+      [&] { return s21::set_intersection(small, large, 1); });
+  run("intersection parallel", m,
+      [&] { return s21::set_intersection(small, large, hardware); });
+  run("union serial", n + m, [&] { return s21::set_union(small, large, 1); });
+  run("union parallel", n + m,
+      [&] { return s21::set_union(small, large, hardware); });
+  run("difference serial", n + m,
+      [&] { return s21::set_difference(large, small, 1); });
+  run("difference parallel", n + m,
+      [&] { return s21::set_difference(large, small, hardware); });
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  Compare("similar", n, n);
+  Compare("skewed 1:1000", n, n / 1000 + 1);
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include "../s21_btree_set.h"
+#include "../s21_set.h"
+#include "bench.h"
+
+namespace {
+// Random insert, lookup, full scan and erase, run against the binary tree
+// set and the B-tree set with the same keys.
+template <typename Set>
+void SetBench(const char *label, const std::vector<int> &keys) {
+  std::vector<int> probes = s21_bench::ShuffledKeys(keys.size(), 42);
+  std::size_t n = keys.size();
+  char name[64];
+  Set set;
+  double ns = s21_bench::NsPerOp(n, [&] {
+    for (int key : keys) set.insert(key);
+  });
+  std::snprintf(name, sizeof(name), "%s insert", label);
+  s21_bench::Report(name, n, ns);
+
+  std::size_t found = 0;
+  ns = s21_bench::NsPerOp(n, [&] {
+    for (int key : probes) found += set.contains(key);
+  });
+  s21_bench::DoNotOptimize(found);
+  std::snprintf(name, sizeof(name), "%s find", label);
+  s21_bench::Report(name, n, ns);
+
+  int rounds = n < 100000 ? 100 : 10;
+  long long sum = 0;
+  ns = s21_bench::NsPerOp(n * rounds, [&] {
+    for (int round = 0; round < rounds; ++round) {
+      for (int key : set) sum += key;
+    }
+  });
+  s21_bench::DoNotOptimize(sum);
+  std::snprintf(name, sizeof(name), "%s scan", label);
+  s21_bench::Report(name, n, ns);
+
+  ns = s21_bench::NsPerOp(n, [&] {
+    for (int key : probes) set.erase(key);
+  });
+  std::snprintf(name, sizeof(name), "%s erase", label);
+  s21_bench::Report(name, n, ns);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  std::vector<int> keys = s21_bench::ShuffledKeys(n);
+  SetBench<s21::set<int>>("s21::set", keys);
+  SetBench<s21::btree_set<int>>("s21::btree_set", keys);
+  return 0;
+}
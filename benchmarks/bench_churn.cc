@@ -0,0 +1,36 @@
+#include <cstdio>
+
+#include "../s21_tree.h"
+#include "bench.h"
+
+// Sliding-window churn: every round erases the oldest keys and inserts
+// newer ones, the pattern that skews a tree that does not rebalance on
+// erase. Reports tree height and lookup latency as the rounds go by.
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  const std::size_t rounds = 10;
+  s21::BinaryTree<int, std::less<int>> tree;
+  std::vector<int> keys = s21_bench::ShuffledKeys(n);
+  for (int key : keys) tree.insert(key);
+
+  int oldest = 0;
+  int next = static_cast<int>(n);
+  std::size_t batch = n / 4;
+  for (std::size_t round = 0; round <= rounds; ++round) {
+    if (round > 0) {
+      for (std::size_t i = 0; i < batch; ++i) {
+        tree.del(oldest++);
+        tree.insert(next++);
+      }
+    }
+    std::vector<int> probes = s21_bench::ShuffledKeys(n, round);
+    std::size_t found = 0;
+    double ns = s21_bench::NsPerOp(probes.size(), [&] {
+      for (int probe : probes) found += tree.contains(probe + oldest);
+    });
+    s21_bench::DoNotOptimize(found);
+    std::printf("round %2zu height %3d ", round, tree.height());
+    s21_bench::Report("BinaryTree find after churn", n, ns);
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../s21_concurrent_map.h"
+#include "../s21_map.h"
+#include "bench.h"
+
+namespace {
+// The setup being replaced: one ordered map behind one mutex.
+class GlobalLockMap {
+ public:
+  bool find(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+
+  void insert_or_assign(int key, int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.insert_or_assign(key, value);
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::map<int, int> map_;
+};
+
+class ShardedMap {
+ public:
+  bool find(int key) { return map_.contains(key); }
+
+  void insert_or_assign(int key, int value) {
+    map_.insert_or_assign(key, value);
+  }
+
+ private:
+  s21::concurrent_map<int, int> map_{256};
+};
+
+// Every thread runs the same number of operations, nine lookups to one
+// write, over keys spread across the whole key range. The reported figure
+// is wall time per operation over all threads, so perfect scaling halves
+// it each time the thread count doubles.
+template <typename Map>
+void ScalingBench(const char *label, const std::vector<int> &keys) {
+  std::size_t n = keys.size();
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    Map map;
+    for (int key : keys) map.insert_or_assign(key, key);
+    std::size_t per_thread = n;
+    double ns = s21_bench::NsPerOp(per_thread * threads, [&] {
+      std::vector<std::thread> workers;
+      for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+          std::size_t found = 0;
+          std::size_t offset = t * 7919;
+          for (std::size_t i = 0; i < per_thread; ++i) {
+            int key = keys[(offset + i) % n];
+            if (i % 10 == 0) {
+              map.insert_or_assign(key, static_cast<int>(i));
+            } else {
+              found += map.find(key);
+            }
+          }
+          s21_bench::DoNotOptimize(found);
+        });
+      }
+      for (std::thread &worker : workers) worker.join();
+    });
+    std::string name = std::string(label) + " threads=" +
+                       std::to_string(threads);
+    s21_bench::Report(name.c_str(), n, ns);
+  }
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 100000);
+  std::vector<int> keys = s21_bench::ShuffledKeys(n);
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  ScalingBench<GlobalLockMap>("mutex + s21::map", keys);
+  ScalingBench<ShardedMap>("s21::concurrent_map", keys);
+  return 0;
+}
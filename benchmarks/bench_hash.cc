@@ -0,0 +1,53 @@
+#include <string>
+#include <unordered_map>
+
+#include "../s21_map.h"
+#include "../s21_unordered_map.h"
+#include "bench.h"
+
+namespace {
+// Random inserts, successful and failed lookups, then erases of every key,
+// run against the hash maps and the ordered map with the same keys.
+template <typename Map>
+void MapBench(const char *label, const std::vector<int> &keys) {
+  std::vector<int> probes = s21_bench::ShuffledKeys(keys.size(), 42);
+  std::size_t n = keys.size();
+  int missing = static_cast<int>(n);
+  std::string name;
+  Map map;
+  double ns = s21_bench::NsPerOp(n, [&] {
+    for (int key : keys) map.insert({key, key});
+  });
+  s21_bench::Report((name = std::string(label) + " insert").c_str(), n, ns);
+
+  long long sum = 0;
+  ns = s21_bench::NsPerOp(n, [&] {
+    for (int key : probes) sum += map.find(key)->second;
+  });
+  s21_bench::Report((name = std::string(label) + " find hit").c_str(), n,
+                    ns);
+
+  std::size_t found = 0;
+  ns = s21_bench::NsPerOp(n, [&] {
+    for (int key : probes) found += map.count(key + missing);
+  });
+  s21_bench::Report((name = std::string(label) + " find miss").c_str(), n,
+                    ns);
+
+  ns = s21_bench::NsPerOp(n, [&] {
+    for (int key : probes) map.erase(key);
+  });
+  s21_bench::Report((name = std::string(label) + " erase").c_str(), n, ns);
+  s21_bench::DoNotOptimize(sum);
+  s21_bench::DoNotOptimize(found);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  std::vector<int> keys = s21_bench::ShuffledKeys(n);
+  MapBench<s21::unordered_map<int, int>>("s21::unordered_map", keys);
+  MapBench<std::unordered_map<int, int>>("std::unordered_map", keys);
+  MapBench<s21::map<int, int>>("s21::map", keys);
+  return 0;
+}
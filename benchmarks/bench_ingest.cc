@@ -0,0 +1,62 @@
+#include <map>
+#include <string>
+#include <utility>
+
+#include "../s21_map.h"
+#include "bench.h"
+
+namespace {
+// Ascending keys with one in every hundred swapped with a key up to a
+// hundred places away: the shape of an append-mostly ingest log.
+std::vector<int> NearlySortedKeys(std::size_t n) {
+  std::vector<int> keys(n);
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i);
+  std::mt19937 random(21);
+  for (std::size_t i = 0; i + 100 < n; i += 100) {
+    std::swap(keys[i + random() % 100], keys[i + random() % 100]);
+  }
+  return keys;
+}
+
+template <typename Map>
+void IngestBench(const char *name, const char *shape,
+                 const std::vector<int> &keys) {
+  std::string label = std::string(name) + " " + shape;
+  {
+    Map map;
+    double ns = s21_bench::NsPerOp(keys.size(), [&] {
+      for (int key : keys) map.insert({key, key});
+    });
+    s21_bench::Report((label + " insert").c_str(), keys.size(), ns);
+  }
+  {
+    Map map;
+    double ns = s21_bench::NsPerOp(keys.size(), [&] {
+      for (int key : keys) map.insert(map.end(), {key, key});
+    });
+    s21_bench::Report((label + " insert(end)").c_str(), keys.size(), ns);
+  }
+  {
+    // Hinting with the previous insertion also catches the keys that
+    // land just behind it.
+    Map map;
+    double ns = s21_bench::NsPerOp(keys.size(), [&] {
+      auto hint = map.end();
+      for (int key : keys) hint = map.insert(hint, {key, key});
+    });
+    s21_bench::Report((label + " insert(prev)").c_str(), keys.size(), ns);
+  }
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  std::vector<int> sorted(n);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::vector<int> nearly = NearlySortedKeys(n);
+  IngestBench<s21::map<int, int>>("s21::map", "sorted", sorted);
+  IngestBench<s21::map<int, int>>("s21::map", "nearly sorted", nearly);
+  IngestBench<std::map<int, int>>("std::map", "sorted", sorted);
+  IngestBench<std::map<int, int>>("std::map", "nearly sorted", nearly);
+  return 0;
+}
@@ -0,0 +1,33 @@
+#include <map>
+
+#include "../s21_map.h"
+#include "bench.h"
+
+namespace {
+int Lookup(s21::map<int, int> &map, int key) {
+  return map.find(key)->second;
+}
+
+int Lookup(std::map<int, int> &map, int key) { return map.find(key)->second; }
+
+template <typename Map>
+void LookupBench(const char *name, const std::vector<int> &keys) {
+  Map map;
+  for (int key : keys) map.insert({key, key});
+  std::vector<int> probes = s21_bench::ShuffledKeys(keys.size(), 42);
+  long long sum = 0;
+  double ns = s21_bench::NsPerOp(probes.size(), [&] {
+    for (int key : probes) sum += Lookup(map, key);
+  });
+  s21_bench::DoNotOptimize(sum);
+  s21_bench::Report(name, keys.size(), ns);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  std::vector<int> keys = s21_bench::ShuffledKeys(n);
+  LookupBench<s21::map<int, int>>("s21::map find", keys);
+  LookupBench<std::map<int, int>>("std::map find", keys);
+  return 0;
+}
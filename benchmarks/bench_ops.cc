@@ -0,0 +1,41 @@
+#include <set>
+
+#include "../s21_set.h"
+#include "bench.h"
+
+namespace {
+template <typename Set>
+void OpsBench(const char *name, const std::vector<int> &keys) {
+  std::string label(name);
+  std::vector<int> probes = s21_bench::ShuffledKeys(keys.size(), 42);
+  Set set;
+  double ns = s21_bench::NsPerOp(keys.size(), [&] {
+    for (int key : keys) set.insert(key);
+  });
+  s21_bench::Report((label + " insert").c_str(), keys.size(), ns);
+
+  std::size_t found = 0;
+  ns = s21_bench::NsPerOp(probes.size(), [&] {
+    for (int key : probes) found += set.find(key) != set.end();
+  });
+  s21_bench::DoNotOptimize(found);
+  s21_bench::Report((label + " find").c_str(), keys.size(), ns);
+
+  ns = s21_bench::NsPerOp(probes.size(), [&] {
+    for (int key : probes) set.erase(key);
+  });
+  s21_bench::Report((label + " erase").c_str(), keys.size(), ns);
+
+  for (int key : keys) set.insert(key);
+  ns = s21_bench::NsPerOp(keys.size(), [&] { Set().swap(set); });
+  s21_bench::Report((label + " destroy").c_str(), keys.size(), ns);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  std::vector<int> keys = s21_bench::ShuffledKeys(n);
+  OpsBench<s21::set<int>>("s21::set", keys);
+  OpsBench<std::set<int>>("std::set", keys);
+  return 0;
+}
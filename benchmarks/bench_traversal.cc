@@ -0,0 +1,40 @@
+#include <map>
+
+#include "../s21_map.h"
+#include "bench.h"
+
+namespace {
+// Full forward and backward scans of a map filled in random order, so the
+// nodes are scattered the way a long-lived container's are.
+template <typename Map>
+void TraversalBench(const char *forward, const char *backward,
+                    const std::vector<int> &keys, int rounds) {
+  Map map;
+  for (int key : keys) map.insert({key, key});
+  long long sum = 0;
+  double ns = s21_bench::NsPerOp(keys.size() * rounds, [&] {
+    for (int round = 0; round < rounds; ++round) {
+      for (auto it = map.begin(); it != map.end(); ++it) sum += it->second;
+    }
+  });
+  s21_bench::Report(forward, keys.size(), ns);
+  ns = s21_bench::NsPerOp(keys.size() * rounds, [&] {
+    for (int round = 0; round < rounds; ++round) {
+      for (auto it = map.end(); it != map.begin();) sum += (--it)->second;
+    }
+  });
+  s21_bench::Report(backward, keys.size(), ns);
+  s21_bench::DoNotOptimize(sum);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::size_t n = s21_bench::SizeFromArgs(argc, argv, 1000000);
+  std::vector<int> keys = s21_bench::ShuffledKeys(n);
+  int rounds = n < 100000 ? 100 : 10;
+  TraversalBench<s21::map<int, int>>("s21::map forward scan",
+                                     "s21::map backward scan", keys, rounds);
+  TraversalBench<std::map<int, int>>("std::map forward scan",
+                                     "std::map backward scan", keys, rounds);
+  return 0;
+}
@@ -0,0 +1,191 @@
+#ifndef SRC_S21_ALLOCATOR_H
+#define SRC_S21_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// Fixed-size block pool. Blocks are carved out of slabs by bumping a
+// pointer and recycled through an intrusive free list; slabs are only
+// returned to the system all at once by Release() or the destructor.
+class NodePool {
+ public:
+  static constexpr std::size_t kAlignment = alignof(std::max_align_t);
+  static constexpr std::size_t kFirstSlabBlocks = 32;
+  static constexpr std::size_t kMaxSlabBlocks = 4096;
+
+  NodePool() noexcept = default;
+
+  explicit NodePool(std::size_t block_size) noexcept {
+    SetBlockSize(block_size);
+  }
+
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  ~NodePool() { Release(); }
+
+  // The block size is fixed by the first request; a pool serves exactly one
+  // node type, everything else goes to the fallback path of the allocator.
+  bool Serves(std::size_t size, std::size_t alignment) noexcept {
+    if (alignment > kAlignment) return false;
+    if (block_size_ == 0) SetBlockSize(size);
+    return RoundUp(size) == block_size_;
+  }
+
+  void *Allocate() {
+    if (free_list_) {
+      FreeBlock *block = free_list_;
+      free_list_ = block->next;
+      return block;
+    }
+    if (bump_ == bump_end_) NewSlab();
+    void *block = bump_;
+    bump_ += block_size_;
+    return block;
+  }
+
+  void Deallocate(void *block) noexcept {
+    FreeBlock *free_block = static_cast<FreeBlock *>(block);
+    free_block->next = free_list_;
+    free_list_ = free_block;
+  }
+
+  void Release() noexcept {
+    while (slabs_) {
+      Slab *next = slabs_->next;
+      ::operator delete(slabs_);
+      slabs_ = next;
+    }
+    free_list_ = nullptr;
+    bump_ = nullptr;
+    bump_end_ = nullptr;
+    slab_blocks_ = kFirstSlabBlocks;
+  }
+
+  std::size_t block_size() const noexcept { return block_size_; }
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct Slab {
+    Slab *next;
+  };
+
+  static std::size_t RoundUp(std::size_t size) noexcept {
+    if (size < sizeof(FreeBlock)) size = sizeof(FreeBlock);
+    return (size + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  void SetBlockSize(std::size_t size) noexcept { block_size_ = RoundUp(size); }
+
+  void NewSlab() {
+    std::size_t header = RoundUp(sizeof(Slab));
+    void *memory = ::operator new(header + block_size_ * slab_blocks_);
+    Slab *slab = static_cast<Slab *>(memory);
+    slab->next = slabs_;
+    slabs_ = slab;
+    bump_ = static_cast<char *>(memory) + header;
+    bump_end_ = bump_ + block_size_ * slab_blocks_;
+    if (slab_blocks_ < kMaxSlabBlocks) slab_blocks_ *= 2;
+  }
+
+  std::size_t block_size_ = 0;
+  std::size_t slab_blocks_ = kFirstSlabBlocks;
+  Slab *slabs_ = nullptr;
+  FreeBlock *free_list_ = nullptr;
+  char *bump_ = nullptr;
+  char *bump_end_ = nullptr;
+};
+
+// Standard-compatible allocator backed by a NodePool. Single-object
+// allocations of the pooled size come from the pool; anything else falls
+// back to ::operator new. Copies and rebinds share the pool, while a
+// container copy gets a pool of its own.
+template <class T>
+class pool_allocator {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <class U>
+  struct rebind {
+    using other = pool_allocator<U>;
+  };
+
+  pool_allocator() : pool_(std::make_shared<NodePool>()) {}
+
+  pool_allocator(const pool_allocator &other) noexcept = default;
+
+  // Moving an allocator must leave the source equal to what it was, so
+  // moves copy: both sides go on sharing the pool.
+  pool_allocator(pool_allocator &&other) noexcept : pool_(other.pool_) {}
+
+  pool_allocator &operator=(const pool_allocator &other) noexcept = default;
+
+  pool_allocator &operator=(pool_allocator &&other) noexcept {
+    pool_ = other.pool_;
+    return *this;
+  }
+
+  template <class U>
+  pool_allocator(const pool_allocator<U> &other) noexcept
+      : pool_(other.pool_) {}
+
+  T *allocate(size_type n) {
+    if (n == 1 && pool_->Serves(sizeof(T), alignof(T))) {
+      return static_cast<T *>(pool_->Allocate());
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, size_type n) noexcept {
+    if (n == 1 && pool_->block_size() != 0 &&
+        pool_->Serves(sizeof(T), alignof(T))) {
+      pool_->Deallocate(p);
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  // Drops every slab at once. Refused while another allocator still shares
+  // the pool, since its blocks would be freed from under it.
+  bool release() noexcept {
+    if (pool_.use_count() != 1) return false;
+    pool_->Release();
+    return true;
+  }
+
+  pool_allocator select_on_container_copy_construction() const {
+    return pool_allocator();
+  }
+
+  template <class U>
+  bool operator==(const pool_allocator<U> &other) const noexcept {
+    return pool_ == other.pool_;
+  }
+
+  template <class U>
+  bool operator!=(const pool_allocator<U> &other) const noexcept {
+    return pool_ != other.pool_;
+  }
+
+ private:
+  template <class U>
+  friend class pool_allocator;
+
+  std::shared_ptr<NodePool> pool_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_ALLOCATOR_H
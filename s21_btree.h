@@ -0,0 +1,765 @@
+#ifndef SRC_S21_BTREE_H
+#define SRC_S21_BTREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "s21_tree.h"
+
+namespace s21 {
+// Key extractors for BTree: sets order values themselves, maps order the
+// first member of their pairs.
+struct BTreeIdentity {
+  template <class T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+struct BTreeSelectFirst {
+  template <class Pair>
+  const typename Pair::first_type &operator()(
+      const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+
+// B-tree keeping up to kSlots sorted values in every node, internal nodes
+// included. Nodes are sized to a few cache lines, so a lookup touches
+// log_B(n) nodes with a binary search inside each instead of chasing one
+// pointer per comparison, and a scan reads neighbouring values out of the
+// same node. Values are relocated between slots by move construction,
+// which must not throw; map keys are moved too, see SlotType. Every
+// insert and erase invalidates iterators.
+template <class Key, class Value, class KeyOf, class Compare,
+          class Allocator = std::allocator<Value>>
+class BTree {
+  struct LeafNode;
+  struct InternalNode;
+
+  using slot_type = typename SlotType<Value>::type;
+  using value_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<slot_type>;
+  using value_traits = std::allocator_traits<value_allocator>;
+  using leaf_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<LeafNode>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using internal_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<InternalNode>;
+  using internal_traits = std::allocator_traits<internal_allocator>;
+
+ public:
+  template <bool Const>
+  struct btree_iterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using iterator = btree_iterator<false>;
+  using const_iterator = btree_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // Leaves are about four cache lines; internal nodes add the child
+  // pointers on top.
+  static constexpr std::size_t kNodeBytes = 256;
+  static constexpr int kSlots = static_cast<int>(std::max<std::size_t>(
+      3, std::min<std::size_t>(
+             (kNodeBytes - 2 * sizeof(void *)) / sizeof(slot_type), 1024)));
+  static constexpr int kMinSlots = kSlots / 2;
+
+  BTree() : BTree(Allocator()) {}
+
+  explicit BTree(const Allocator &alloc) noexcept : allocator_(alloc) {}
+
+  BTree(const Compare &comparator, const Allocator &alloc)
+      : comparator_(comparator), allocator_(alloc) {}
+
+  BTree(const BTree &other)
+      : comparator_(other.comparator_),
+        allocator_(value_traits::select_on_container_copy_construction(
+            other.allocator_)) {
+    try {
+      for (const value_type &value : other) AppendBack(value);
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+  BTree(BTree &&other) noexcept
+      : root_(std::exchange(other.root_, nullptr)),
+        leftmost_(std::exchange(other.leftmost_, nullptr)),
+        rightmost_(std::exchange(other.rightmost_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        comparator_(other.comparator_),
+        allocator_(std::move(other.allocator_)) {}
+
+  BTree &operator=(const BTree &other) {
+    if (this == &other) return *this;
+    Clear();
+    comparator_ = other.comparator_;
+    for (const value_type &value : other) AppendBack(value);
+    return *this;
+  }
+
+  BTree &operator=(BTree &&other) {
+    if (this == &other) return *this;
+    Clear();
+    comparator_ = other.comparator_;
+    if (value_traits::propagate_on_container_move_assignment::value ||
+        allocator_ == other.allocator_) {
+      if (value_traits::propagate_on_container_move_assignment::value) {
+        allocator_ = std::move(other.allocator_);
+      }
+      root_ = std::exchange(other.root_, nullptr);
+      leftmost_ = std::exchange(other.leftmost_, nullptr);
+      rightmost_ = std::exchange(other.rightmost_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    } else {
+      for (value_type &value : other) AppendBack(std::move(value));
+      other.Clear();
+    }
+    return *this;
+  }
+
+  ~BTree() noexcept { Clear(); }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(allocator_);
+  }
+
+  iterator begin() noexcept { return iterator(leftmost_, 0); }
+
+  const_iterator begin() const noexcept { return const_iterator(leftmost_, 0); }
+
+  iterator end() noexcept { return Mutable(std::as_const(*this).end()); }
+
+  const_iterator end() const noexcept {
+    return const_iterator(rightmost_, rightmost_ ? rightmost_->count : 0);
+  }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+
+  const_iterator cend() const noexcept { return end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  // Number of levels, 0 for an empty tree.
+  int height() const noexcept {
+    int height = 0;
+    for (LeafNode *node = root_; node; ++height) {
+      node = node->leaf ? nullptr : Child(node, 0);
+    }
+    return height;
+  }
+
+  void clear() noexcept { Clear(); }
+
+  void swap(BTree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(leftmost_, other.leftmost_);
+    std::swap(rightmost_, other.rightmost_);
+    std::swap(size_, other.size_);
+    std::swap(comparator_, other.comparator_);
+    if (value_traits::propagate_on_container_swap::value) {
+      std::swap(allocator_, other.allocator_);
+    }
+  }
+
+  // Lookups on a const tree hand out const_iterators; the non-const
+  // overloads run the same search.
+  template <class K>
+  iterator find(const K &key) {
+    return Mutable(std::as_const(*this).find(key));
+  }
+
+  template <class K>
+  const_iterator find(const K &key) const {
+    for (LeafNode *node = root_; node;) {
+      int pos = LowerBoundIn(node, key);
+      if (pos < node->count && !comparator_(key, KeyOf()(*Slot(node, pos)))) {
+        return const_iterator(node, pos);
+      }
+      if (node->leaf) break;
+      node = Child(node, pos);
+    }
+    return end();
+  }
+
+  template <class K>
+  bool contains(const K &key) const {
+    return find(key) != end();
+  }
+
+  // Deeper candidates are always closer to key, so the last one seen on
+  // the way down is the bound.
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return Mutable(std::as_const(*this).lower_bound(key));
+  }
+
+  template <class K>
+  const_iterator lower_bound(const K &key) const {
+    const_iterator result = end();
+    for (LeafNode *node = root_; node;) {
+      int pos = LowerBoundIn(node, key);
+      if (pos < node->count) result = const_iterator(node, pos);
+      if (node->leaf) break;
+      node = Child(node, pos);
+    }
+    return result;
+  }
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return Mutable(std::as_const(*this).upper_bound(key));
+  }
+
+  template <class K>
+  const_iterator upper_bound(const K &key) const {
+    const_iterator result = end();
+    for (LeafNode *node = root_; node;) {
+      int pos = UpperBoundIn(node, key);
+      if (pos < node->count) result = const_iterator(node, pos);
+      if (node->leaf) break;
+      node = Child(node, pos);
+    }
+    return result;
+  }
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <class K>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <class K>
+  size_type count(const K &key) const {
+    size_type count = 0;
+    const_iterator last = end();
+    for (const_iterator it = lower_bound(key);
+         it != last && !comparator_(key, KeyOf()(*it)); ++it) {
+      ++count;
+    }
+    return count;
+  }
+
+  // Inserts value unless an equal key is present. Values greater than
+  // everything stored go straight to the end of the rightmost leaf.
+  template <class V>
+  std::pair<iterator, bool> insert_unique(V &&value) {
+    const key_type &key = KeyOf()(value);
+    if (!root_ || comparator_(LastKey(), key)) {
+      return std::make_pair(AppendBack(std::forward<V>(value)), true);
+    }
+    for (LeafNode *node = root_;;) {
+      int pos = LowerBoundIn(node, key);
+      if (pos < node->count && !comparator_(key, KeyOf()(*Slot(node, pos)))) {
+        return std::make_pair(iterator(node, pos), false);
+      }
+      if (node->leaf) {
+        return std::make_pair(InsertAt(node, pos, std::forward<V>(value)),
+                              true);
+      }
+      node = Child(node, pos);
+    }
+  }
+
+  // Inserts value after any elements with an equal key.
+  template <class V>
+  iterator insert_multi(V &&value) {
+    const key_type &key = KeyOf()(value);
+    if (!root_ || !comparator_(key, LastKey())) {
+      return AppendBack(std::forward<V>(value));
+    }
+    for (LeafNode *node = root_;;) {
+      int pos = UpperBoundIn(node, key);
+      if (node->leaf) return InsertAt(node, pos, std::forward<V>(value));
+      node = Child(node, pos);
+    }
+  }
+
+  void erase(const_iterator pos) {
+    if (pos == cend()) return;
+    EraseAt(pos.node_, pos.position_);
+  }
+
+  template <class K>
+  size_type erase_unique(const K &key) {
+    iterator it = find(key);
+    if (it == end()) return 0;
+    EraseAt(it.node_, it.position_);
+    return 1;
+  }
+
+  template <class K>
+  size_type erase_multi(const K &key) {
+    size_type count = 0;
+    for (iterator it = lower_bound(key);
+         it != end() && !comparator_(key, KeyOf()(*it));
+         it = lower_bound(key)) {
+      EraseAt(it.node_, it.position_);
+      ++count;
+    }
+    return count;
+  }
+
+ private:
+  struct LeafNode {
+    InternalNode *parent;
+    std::uint16_t position;
+    std::uint16_t count;
+    bool leaf;
+    alignas(slot_type) unsigned char storage[kSlots * sizeof(slot_type)];
+  };
+
+  struct InternalNode : LeafNode {
+    LeafNode *children[kSlots + 1];
+  };
+
+  static iterator Mutable(const_iterator it) noexcept {
+    return iterator(it.node_, it.position_);
+  }
+
+  static slot_type *RawSlot(LeafNode *node, int i) noexcept {
+    return std::launder(reinterpret_cast<slot_type *>(
+        node->storage + i * sizeof(slot_type)));
+  }
+
+  // The slot as the value_type it is handed out as; pair<Key, T> and
+  // pair<const Key, T> share their layout.
+  static Value *Slot(LeafNode *node, int i) noexcept {
+    return reinterpret_cast<Value *>(RawSlot(node, i));
+  }
+
+  static LeafNode *Child(LeafNode *node, int i) noexcept {
+    return static_cast<InternalNode *>(node)->children[i];
+  }
+
+  static void SetChild(LeafNode *node, int i, LeafNode *child) noexcept {
+    static_cast<InternalNode *>(node)->children[i] = child;
+    child->parent = static_cast<InternalNode *>(node);
+    child->position = static_cast<std::uint16_t>(i);
+  }
+
+  const key_type &LastKey() const noexcept {
+    return KeyOf()(*Slot(rightmost_, rightmost_->count - 1));
+  }
+
+  LeafNode *NewNode(bool leaf) {
+    LeafNode *node;
+    if (leaf) {
+      leaf_allocator alloc(allocator_);
+      node = ::new (static_cast<void *>(leaf_traits::allocate(alloc, 1)))
+          LeafNode;
+    } else {
+      internal_allocator alloc(allocator_);
+      node = ::new (static_cast<void *>(internal_traits::allocate(alloc, 1)))
+          InternalNode;
+    }
+    node->parent = nullptr;
+    node->position = 0;
+    node->count = 0;
+    node->leaf = leaf;
+    return node;
+  }
+
+  // Frees the node itself; its values and children must be gone already.
+  void FreeNode(LeafNode *node) noexcept {
+    if (node->leaf) {
+      leaf_allocator alloc(allocator_);
+      leaf_traits::deallocate(alloc, node, 1);
+    } else {
+      internal_allocator alloc(allocator_);
+      internal_traits::deallocate(alloc, static_cast<InternalNode *>(node), 1);
+    }
+  }
+
+  // The depth is log_B(n), a handful of levels, so recursion is fine here.
+  void DestroySubtree(LeafNode *node) noexcept {
+    for (int i = 0; i < node->count; ++i) DestroySlot(node, i);
+    if (!node->leaf) {
+      for (int i = 0; i <= node->count; ++i) DestroySubtree(Child(node, i));
+    }
+    FreeNode(node);
+  }
+
+  void Clear() noexcept {
+    if (root_) DestroySubtree(root_);
+    root_ = nullptr;
+    leftmost_ = nullptr;
+    rightmost_ = nullptr;
+    size_ = 0;
+  }
+
+  template <class... Args>
+  void ConstructSlot(LeafNode *node, int i, Args &&...args) {
+    value_traits::construct(allocator_, RawSlot(node, i),
+                            std::forward<Args>(args)...);
+  }
+
+  void DestroySlot(LeafNode *node, int i) noexcept {
+    value_traits::destroy(allocator_, RawSlot(node, i));
+  }
+
+  // Shifts, splits, borrows and merges all relocate with this, halfway
+  // through rearranging a node, so it has to be noexcept.
+  static_assert(std::is_nothrow_move_constructible<slot_type>::value,
+                "s21::BTree: values must be nothrow move constructible");
+
+  void Relocate(LeafNode *to, int i, LeafNode *from, int j) noexcept {
+    ConstructSlot(to, i, std::move(*RawSlot(from, j)));
+    DestroySlot(from, j);
+  }
+
+  // Branch-free binary searches: the range halves the same way whatever
+  // the comparisons return, so the compiler turns the step into a
+  // conditional move instead of a mispredicted jump per level.
+  template <class K>
+  int LowerBoundIn(LeafNode *node, const K &key) const {
+    if (node->count == 0) return 0;
+    int first = 0;
+    for (int len = node->count; len > 1;) {
+      int half = len / 2;
+      first += comparator_(KeyOf()(*Slot(node, first + half - 1)), key)
+                   ? half
+                   : 0;
+      len -= half;
+    }
+    return first + (comparator_(KeyOf()(*Slot(node, first)), key) ? 1 : 0);
+  }
+
+  template <class K>
+  int UpperBoundIn(LeafNode *node, const K &key) const {
+    if (node->count == 0) return 0;
+    int first = 0;
+    for (int len = node->count; len > 1;) {
+      int half = len / 2;
+      first += comparator_(key, KeyOf()(*Slot(node, first + half - 1)))
+                   ? 0
+                   : half;
+      len -= half;
+    }
+    return first + (comparator_(key, KeyOf()(*Slot(node, first))) ? 0 : 1);
+  }
+
+  template <class V>
+  iterator AppendBack(V &&value) {
+    if (!root_) {
+      root_ = leftmost_ = rightmost_ = NewNode(true);
+    }
+    return InsertAt(rightmost_, rightmost_->count, std::forward<V>(value));
+  }
+
+  // Constructs a value at pos of a leaf, splitting the leaf first when it
+  // is full. Appending at either end of a leaf splits it unevenly, so
+  // ascending or descending input fills nodes instead of halving them.
+  template <class V>
+  iterator InsertAt(LeafNode *node, int pos, V &&value) {
+    if (node->count == kSlots) {
+      int mid = pos == kSlots ? kSlots - 1 : pos == 0 ? 1 : kSlots / 2;
+      LeafNode *sibling = SplitNode(node, mid);
+      if (pos > mid) {
+        pos -= mid + 1;
+        node = sibling;
+      }
+    }
+    for (int i = node->count; i > pos; --i) Relocate(node, i, node, i - 1);
+    try {
+      ConstructSlot(node, pos, std::forward<V>(value));
+    } catch (...) {
+      for (int i = pos; i < node->count; ++i) Relocate(node, i, node, i + 1);
+      if (node->count == 0) RebalanceAfterErase(node);
+      throw;
+    }
+    ++node->count;
+    ++size_;
+    return iterator(node, pos);
+  }
+
+  // Moves the values after mid into a new right sibling and the value at
+  // mid up into the parent, splitting a full parent first and growing a
+  // new root above the old one when needed.
+  LeafNode *SplitNode(LeafNode *node, int mid) {
+    LeafNode *sibling = NewNode(node->leaf);
+    try {
+      if (!node->parent) {
+        LeafNode *root = NewNode(false);
+        SetChild(root, 0, node);
+        root_ = root;
+      } else if (node->parent->count == kSlots) {
+        SplitNode(node->parent, kSlots / 2);
+      }
+    } catch (...) {
+      FreeNode(sibling);
+      throw;
+    }
+    int moved = node->count - mid - 1;
+    for (int i = 0; i < moved; ++i) Relocate(sibling, i, node, mid + 1 + i);
+    if (!node->leaf) {
+      for (int i = 0; i <= moved; ++i) {
+        SetChild(sibling, i, Child(node, mid + 1 + i));
+      }
+    }
+    sibling->count = static_cast<std::uint16_t>(moved);
+    LeafNode *parent = node->parent;
+    int pos = node->position;
+    for (int i = parent->count; i > pos; --i) {
+      Relocate(parent, i, parent, i - 1);
+      SetChild(parent, i + 1, Child(parent, i));
+    }
+    Relocate(parent, pos, node, mid);
+    SetChild(parent, pos + 1, sibling);
+    ++parent->count;
+    node->count = static_cast<std::uint16_t>(mid);
+    if (node == rightmost_) rightmost_ = sibling;
+    return sibling;
+  }
+
+  // A value in an internal node is replaced by its in-order predecessor,
+  // which always sits at the end of a leaf, so removal itself only ever
+  // happens in leaves.
+  void EraseAt(LeafNode *node, int pos) noexcept {
+    DestroySlot(node, pos);
+    if (node->leaf) {
+      for (int i = pos + 1; i < node->count; ++i) {
+        Relocate(node, i - 1, node, i);
+      }
+    } else {
+      LeafNode *leaf = Child(node, pos);
+      while (!leaf->leaf) leaf = Child(leaf, leaf->count);
+      Relocate(node, pos, leaf, leaf->count - 1);
+      node = leaf;
+    }
+    --node->count;
+    --size_;
+    RebalanceAfterErase(node);
+  }
+
+  // Refills an underfull node from a sibling that can spare a value, or
+  // merges it with one and carries on with the parent, which lost a value.
+  void RebalanceAfterErase(LeafNode *node) noexcept {
+    while (node != root_ && node->count < kMinSlots) {
+      LeafNode *parent = node->parent;
+      int pos = node->position;
+      LeafNode *left = pos > 0 ? Child(parent, pos - 1) : nullptr;
+      LeafNode *right = pos < parent->count ? Child(parent, pos + 1) : nullptr;
+      if (left && left->count > kMinSlots) {
+        RotateRight(parent, pos - 1);
+        return;
+      }
+      if (right && right->count > kMinSlots) {
+        RotateLeft(parent, pos);
+        return;
+      }
+      MergeChildren(parent, left ? pos - 1 : pos);
+      node = parent;
+    }
+    if (root_->count == 0) {
+      LeafNode *old_root = root_;
+      if (old_root->leaf) {
+        root_ = leftmost_ = rightmost_ = nullptr;
+      } else {
+        root_ = Child(old_root, 0);
+        root_->parent = nullptr;
+        root_->position = 0;
+      }
+      FreeNode(old_root);
+    }
+  }
+
+  // Moves the last value of child i through the parent into child i + 1.
+  void RotateRight(LeafNode *parent, int i) noexcept {
+    LeafNode *left = Child(parent, i);
+    LeafNode *right = Child(parent, i + 1);
+    for (int j = right->count; j > 0; --j) Relocate(right, j, right, j - 1);
+    Relocate(right, 0, parent, i);
+    Relocate(parent, i, left, left->count - 1);
+    if (!right->leaf) {
+      for (int j = right->count + 1; j > 0; --j) {
+        SetChild(right, j, Child(right, j - 1));
+      }
+      SetChild(right, 0, Child(left, left->count));
+    }
+    --left->count;
+    ++right->count;
+  }
+
+  // Moves the first value of child i + 1 through the parent into child i.
+  void RotateLeft(LeafNode *parent, int i) noexcept {
+    LeafNode *left = Child(parent, i);
+    LeafNode *right = Child(parent, i + 1);
+    Relocate(left, left->count, parent, i);
+    Relocate(parent, i, right, 0);
+    for (int j = 1; j < right->count; ++j) Relocate(right, j - 1, right, j);
+    if (!right->leaf) {
+      SetChild(left, left->count + 1, Child(right, 0));
+      for (int j = 1; j <= right->count; ++j) {
+        SetChild(right, j - 1, Child(right, j));
+      }
+    }
+    ++left->count;
+    --right->count;
+  }
+
+  // Folds child i + 1 and the value between them into child i.
+  void MergeChildren(LeafNode *parent, int i) noexcept {
+    LeafNode *left = Child(parent, i);
+    LeafNode *right = Child(parent, i + 1);
+    int base = left->count + 1;
+    Relocate(left, left->count, parent, i);
+    for (int j = 0; j < right->count; ++j) Relocate(left, base + j, right, j);
+    if (!left->leaf) {
+      for (int j = 0; j <= right->count; ++j) {
+        SetChild(left, base + j, Child(right, j));
+      }
+    }
+    left->count = static_cast<std::uint16_t>(base + right->count);
+    for (int j = i + 1; j < parent->count; ++j) {
+      Relocate(parent, j - 1, parent, j);
+      SetChild(parent, j, Child(parent, j + 1));
+    }
+    --parent->count;
+    if (right == rightmost_) rightmost_ = left;
+    FreeNode(right);
+  }
+
+  // In-order steps over (node, position) pairs. The end position is one
+  // past the last slot of the rightmost leaf.
+  static void Increment(LeafNode *&node, int &pos) noexcept {
+    if (!node->leaf) {
+      node = Child(node, pos + 1);
+      while (!node->leaf) node = Child(node, 0);
+      pos = 0;
+      return;
+    }
+    if (++pos < node->count) return;
+    LeafNode *leaf = node;
+    int end = pos;
+    while (pos == node->count && node->parent) {
+      pos = node->position;
+      node = node->parent;
+    }
+    if (pos == node->count) {
+      node = leaf;
+      pos = end;
+    }
+  }
+
+  static void Decrement(LeafNode *&node, int &pos) noexcept {
+    if (!node->leaf) {
+      node = Child(node, pos);
+      while (!node->leaf) node = Child(node, node->count);
+      pos = node->count - 1;
+      return;
+    }
+    while (pos == 0 && node->parent) {
+      pos = node->position;
+      node = node->parent;
+    }
+    --pos;
+  }
+
+  LeafNode *root_ = nullptr;
+  LeafNode *leftmost_ = nullptr;
+  LeafNode *rightmost_ = nullptr;
+  size_type size_ = 0;
+  Compare comparator_;
+  value_allocator allocator_;
+
+ public:
+  template <bool Const>
+  struct btree_iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = BTree::value_type;
+    using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+    using reference = std::conditional_t<Const, const value_type &,
+                                         value_type &>;
+
+    btree_iterator() = default;
+
+    template <bool C = Const, class = std::enable_if_t<C>>
+    btree_iterator(const btree_iterator<false> &other) noexcept
+        : node_(other.node_), position_(other.position_) {}
+
+    reference operator*() const { return *Slot(node_, position_); }
+
+    pointer operator->() const { return Slot(node_, position_); }
+
+    btree_iterator &operator++() noexcept {
+      Increment(node_, position_);
+      return *this;
+    }
+
+    btree_iterator operator++(int) noexcept {
+      btree_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    btree_iterator &operator--() noexcept {
+      Decrement(node_, position_);
+      return *this;
+    }
+
+    btree_iterator operator--(int) noexcept {
+      btree_iterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    bool operator==(const btree_iterator &other) const noexcept {
+      return node_ == other.node_ && position_ == other.position_;
+    }
+
+    bool operator!=(const btree_iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    friend class BTree;
+    friend struct btree_iterator<!Const>;
+
+    btree_iterator(LeafNode *node, int position) noexcept
+        : node_(node), position_(position) {}
+
+    LeafNode *node_ = nullptr;
+    int position_ = 0;
+  };
+};
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_H
@@ -0,0 +1,207 @@
+#ifndef SRC_S21_BTREE_MAP_H
+#define SRC_S21_BTREE_MAP_H
+
+#include <memory_resource>
+#include <stdexcept>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Map with the interface of s21::map kept in a B-tree; see btree_set for
+// how it differs from the binary tree containers. Compare orders keys,
+// as in std::map.
+template <typename Key, typename T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map {
+ public:
+  // in-class type overrides
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree_type =
+      BTree<key_type, value_type, BTreeSelectFirst, Compare, Allocator>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = typename tree_type::reverse_iterator;
+  using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  // main methods for interacting with the class
+  btree_map() = default;
+
+  explicit btree_map(const Allocator& alloc) : tree_(alloc) {}
+
+  btree_map(std::initializer_list<value_type> const& items,
+            const Allocator& alloc = Allocator())
+      : btree_map(items.begin(), items.end(), alloc) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  btree_map(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+      : tree_(alloc) {
+    for (; first != last; ++first) tree_.insert_unique(*first);
+  }
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+  // methods for accessing the elements of the class
+  mapped_type& at(const key_type& key) { return FindByKey(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  mapped_type& at(const K& key) {
+    return FindByKey(key);
+  }
+
+  mapped_type& operator[](const key_type& key) {
+    iterator it = tree_.find(key);
+    if (it == tree_.end()) {
+      it = tree_.insert_unique(value_type(key, mapped_type())).first;
+    }
+    return it->second;
+  }
+
+  // methods for iterating over class elements (access to iterator)
+  iterator begin() { return tree_.begin(); }
+
+  iterator end() { return tree_.end(); }
+
+  const_iterator begin() const { return tree_.cbegin(); }
+
+  const_iterator end() const { return tree_.cend(); }
+
+  reverse_iterator rbegin() { return tree_.rbegin(); }
+
+  reverse_iterator rend() { return tree_.rend(); }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  // methods for accessing the container capacity information
+  bool empty() const { return tree_.empty(); }
+
+  size_type size() const { return tree_.size(); }
+
+  size_type max_size() const { return tree_.max_size(); }
+
+  // methods for modifying a container
+  void clear() { tree_.clear(); }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return tree_.insert_unique(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return tree_.insert_unique(std::move(value));
+  }
+
+  std::pair<iterator, bool> insert(const key_type& key,
+                                   const mapped_type& obj) {
+    return tree_.insert_unique(value_type(key, obj));
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const key_type& key,
+                                             const mapped_type& obj) {
+    std::pair<iterator, bool> ret = insert(key, obj);
+    if (!ret.second) ret.first->second = obj;
+    return ret;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return tree_.insert_unique(value_type(std::forward<Args>(args)...));
+  }
+
+  size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K& key) {
+    return tree_.erase_unique(key);
+  }
+
+  void erase(iterator pos) { tree_.erase(pos); }
+
+  void erase(const_iterator pos) { tree_.erase(pos); }
+
+  // Moves over the elements whose key is not present yet; the rest stay
+  // in other.
+  void merge(btree_map& other) {
+    if (this == &other) return;
+    tree_type kept(other.get_allocator());
+    for (value_type& value : other.tree_) {
+      if (!tree_.insert_unique(std::move(value)).second) {
+        kept.insert_multi(std::move(value));
+      }
+    }
+    other.tree_ = std::move(kept);
+  }
+
+  void swap(btree_map& other) { tree_.swap(other.tree_); }
+
+  // methods for viewing the container
+  size_type count(const key_type& key) const {
+    return tree_.contains(key) ? 1 : 0;
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K& key) const {
+    return tree_.contains(key) ? 1 : 0;
+  }
+
+  iterator find(const key_type& key) { return tree_.find(key); }
+
+  const_iterator find(const key_type& key) const { return tree_.find(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K& key) {
+    return tree_.find(key);
+  }
+
+  bool contains(const key_type& key) const { return tree_.contains(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K& key) const {
+    return tree_.contains(key);
+  }
+
+  iterator lower_bound(const key_type& key) { return tree_.lower_bound(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K& key) {
+    return tree_.lower_bound(key);
+  }
+
+  iterator upper_bound(const key_type& key) { return tree_.upper_bound(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K& key) {
+    return tree_.upper_bound(key);
+  }
+
+ private:
+  template <class K>
+  mapped_type& FindByKey(const K& key) {
+    iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("Key is not in the map");
+    return it->second;
+  }
+
+  tree_type tree_;
+};
+
+namespace pmr {
+template <class Key, class T, class Compare = std::less<Key>>
+using btree_map =
+    s21::btree_map<Key, T, Compare,
+                   std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_MAP_H
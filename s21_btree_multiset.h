@@ -0,0 +1,154 @@
+#ifndef SRC_S21_BTREE_MULTISET_H
+#define SRC_S21_BTREE_MULTISET_H
+
+#include <memory_resource>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Multiset with the interface of s21::multiset kept in a B-tree; see
+// btree_set for how it differs from the binary tree containers.
+template <class T, class Compare = std::less<T>,
+          class Allocator = std::allocator<T>>
+class btree_multiset {
+ public:
+  // in-class type overrides
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using tree_type = BTree<T, T, BTreeIdentity, Compare, Allocator>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  // main methods for interacting with the class
+  btree_multiset() = default;
+
+  explicit btree_multiset(const Allocator &alloc) : tree_(alloc) {}
+
+  btree_multiset(std::initializer_list<value_type> const &items,
+                 const Allocator &alloc = Allocator())
+      : btree_multiset(items.begin(), items.end(), alloc) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  btree_multiset(InputIt first, InputIt last,
+                 const Allocator &alloc = Allocator())
+      : tree_(alloc) {
+    for (; first != last; ++first) tree_.insert_multi(*first);
+  }
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+  // methods for iterating over class elements (access to iterators)
+  iterator begin() const { return tree_.cbegin(); }
+
+  iterator end() const { return tree_.cend(); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return tree_.empty(); }
+
+  size_type size() const noexcept { return tree_.size(); }
+
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // methods for modifying a container
+  void clear() { tree_.clear(); }
+
+  iterator insert(const_reference value) { return tree_.insert_multi(value); }
+
+  iterator insert(value_type &&value) {
+    return tree_.insert_multi(std::move(value));
+  }
+
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return tree_.insert_multi(value_type(std::forward<Args>(args)...));
+  }
+
+  // Removes all elements equal to value.
+  size_type erase(const T &value) { return tree_.erase_multi(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K &key) {
+    return tree_.erase_multi(key);
+  }
+
+  void erase(iterator pos) { tree_.erase(pos); }
+
+  void merge(btree_multiset &other) {
+    if (this == &other) return;
+    for (value_type &value : other.tree_) tree_.insert_multi(std::move(value));
+    other.clear();
+  }
+
+  void swap(btree_multiset &other) { tree_.swap(other.tree_); }
+
+  // methods for viewing the container
+  size_type count(const_reference value) const { return tree_.count(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K &key) const {
+    return tree_.count(key);
+  }
+
+  iterator find(const_reference value) const { return tree_.find(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K &key) const {
+    return tree_.find(key);
+  }
+
+  bool contains(const_reference value) const { return tree_.contains(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K &key) const {
+    return tree_.contains(key);
+  }
+
+  iterator lower_bound(const_reference key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  iterator upper_bound(const_reference key) const {
+    return tree_.upper_bound(key);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K &key) const {
+    return tree_.upper_bound(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const_reference key) const {
+    return tree_.equal_range(key);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return tree_.equal_range(key);
+  }
+
+ private:
+  tree_type tree_;
+};
+
+namespace pmr {
+template <class T, class Compare = std::less<T>>
+using btree_multiset =
+    s21::btree_multiset<T, Compare, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_MULTISET_H
@@ -0,0 +1,155 @@
+#ifndef SRC_S21_BTREE_SET_H
+#define SRC_S21_BTREE_SET_H
+
+#include <memory_resource>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Set with the interface of s21::set kept in a B-tree. Lookups and scans
+// are far more cache friendly, but any insert or erase invalidates all
+// iterators, and emplace() constructs one element from its arguments.
+template <class T, class Compare = std::less<T>,
+          class Allocator = std::allocator<T>>
+class btree_set {
+ public:
+  // in-class type overrides
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using tree_type = BTree<T, T, BTreeIdentity, Compare, Allocator>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  // main methods for interacting with the class
+  btree_set() = default;
+
+  explicit btree_set(const Allocator &alloc) : tree_(alloc) {}
+
+  btree_set(std::initializer_list<value_type> const &items,
+            const Allocator &alloc = Allocator())
+      : btree_set(items.begin(), items.end(), alloc) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  btree_set(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+      : tree_(alloc) {
+    for (; first != last; ++first) tree_.insert_unique(*first);
+  }
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+  // methods for iterating over class elements (access to iterators)
+  iterator begin() const { return tree_.cbegin(); }
+
+  iterator end() const { return tree_.cend(); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return tree_.empty(); }
+
+  size_type size() const noexcept { return tree_.size(); }
+
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // methods for modifying a container
+  void clear() { tree_.clear(); }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return tree_.insert_unique(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return tree_.insert_unique(std::move(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return tree_.insert_unique(value_type(std::forward<Args>(args)...));
+  }
+
+  size_type erase(const T &value) { return tree_.erase_unique(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K &key) {
+    return tree_.erase_unique(key);
+  }
+
+  void erase(iterator pos) { tree_.erase(pos); }
+
+  // Moves over the elements whose key is not present yet; the rest stay
+  // in other.
+  void merge(btree_set &other) {
+    if (this == &other) return;
+    tree_type kept(other.get_allocator());
+    for (value_type &value : other.tree_) {
+      if (!tree_.insert_unique(std::move(value)).second) {
+        kept.insert_multi(std::move(value));
+      }
+    }
+    other.tree_ = std::move(kept);
+  }
+
+  void swap(btree_set &other) { tree_.swap(other.tree_); }
+
+  // methods for viewing the container
+  size_type count(const_reference value) const {
+    return tree_.contains(value) ? 1 : 0;
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K &key) const {
+    return tree_.contains(key) ? 1 : 0;
+  }
+
+  iterator find(const_reference value) const { return tree_.find(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K &key) const {
+    return tree_.find(key);
+  }
+
+  bool contains(const_reference value) const { return tree_.contains(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K &key) const {
+    return tree_.contains(key);
+  }
+
+  iterator lower_bound(const_reference key) const {
+    return tree_.lower_bound(key);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K &key) const {
+    return tree_.lower_bound(key);
+  }
+
+  iterator upper_bound(const_reference key) const {
+    return tree_.upper_bound(key);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K &key) const {
+    return tree_.upper_bound(key);
+  }
+
+ private:
+  tree_type tree_;
+};
+
+namespace pmr {
+template <class T, class Compare = std::less<T>>
+using btree_set =
+    s21::btree_set<T, Compare, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_SET_H
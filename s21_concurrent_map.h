@@ -0,0 +1,254 @@
+#ifndef SRC_S21_CONCURRENT_MAP_H
+#define SRC_S21_CONCURRENT_MAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "s21_unordered_map.h"
+
+namespace s21 {
+// Hash map safe for concurrent use, split into independently locked
+// shards so that threads touching different keys rarely wait for each
+// other. Each shard is an s21::unordered_map behind a reader-writer lock:
+// lookups share it, modifications take it exclusively. Every operation on
+// a single key is atomic. Elements are never handed out by reference;
+// callers read copies or run a callback while the shard is locked, and the
+// callback must not call back into the same map.
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class concurrent_map {
+ public:
+  // in-class type overrides
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using shard_type = s21::unordered_map<Key, T, Hash, KeyEqual, Allocator>;
+  using size_type = std::size_t;
+
+  // main methods for interacting with the class
+  concurrent_map() : concurrent_map(DefaultShardCount()) {}
+
+  // shard_count is rounded up to a power of two.
+  explicit concurrent_map(size_type shard_count) {
+    while (shard_count_ < shard_count) {
+      shard_count_ *= 2;
+      ++shard_bits_;
+    }
+    shards_ = std::make_unique<Shard[]>(shard_count_);
+  }
+
+  concurrent_map(std::initializer_list<value_type> const &items)
+      : concurrent_map() {
+    for (const value_type &item : items) insert(item.first, item.second);
+  }
+
+  concurrent_map(const concurrent_map &) = delete;
+
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  size_type shard_count() const noexcept { return shard_count_; }
+
+  // methods for accessing the container capacity information
+  // Sums the shards one after another, so under concurrent modification
+  // the result is only a momentary estimate.
+  size_type size() const {
+    size_type size = 0;
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+      size += shards_[i].map.size();
+    }
+    return size;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // methods for accessing the elements of the class
+  // Copy of the mapped value, or nothing when key is absent.
+  std::optional<mapped_type> find(const key_type &key) const {
+    const Shard &shard = ShardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return std::nullopt;
+    return it->second;
+  }
+
+  mapped_type at(const key_type &key) const {
+    std::optional<mapped_type> value = find(key);
+    if (!value) throw std::out_of_range("Key is not in the map");
+    return std::move(*value);
+  }
+
+  bool contains(const key_type &key) const {
+    const Shard &shard = ShardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.contains(key);
+  }
+
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  // Runs f(const mapped_type &) under the shared lock if key is present.
+  template <class F>
+  bool visit(const key_type &key, F &&f) const {
+    const Shard &shard = ShardFor(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return false;
+    std::forward<F>(f)(static_cast<const mapped_type &>(it->second));
+    return true;
+  }
+
+  // methods for modifying a container
+  // Returns whether the element was inserted.
+  bool insert(const key_type &key, const mapped_type &obj) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.try_emplace(key, obj).second;
+  }
+
+  template <typename... Args>
+  bool try_emplace(const key_type &key, Args &&...args) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+  }
+
+  // Returns true if the element was inserted, false if it was assigned.
+  bool insert_or_assign(const key_type &key, const mapped_type &obj) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.insert_or_assign(key, obj).second;
+  }
+
+  // Runs f(mapped_type &) under the exclusive lock if key is present.
+  template <class F>
+  bool update(const key_type &key, F &&f) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return false;
+    std::forward<F>(f)(it->second);
+    return true;
+  }
+
+  // Runs f(mapped_type &) under the exclusive lock on the value for key,
+  // default-constructing it first when absent. Returns whether it was
+  // inserted.
+  template <class F>
+  bool upsert(const key_type &key, F &&f) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto ret = shard.map.try_emplace(key);
+    std::forward<F>(f)(ret.first->second);
+    return ret.second;
+  }
+
+  // Replaces the value for key with f(const mapped_type *current), where
+  // current is null when key is absent; returning std::nullopt removes the
+  // element instead. The whole step runs under the exclusive lock.
+  template <class F>
+  void compute(const key_type &key, F &&f) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    const mapped_type *current =
+        it == shard.map.end() ? nullptr : &it->second;
+    std::optional<mapped_type> next = std::forward<F>(f)(current);
+    if (!next) {
+      if (current) shard.map.erase(it);
+    } else if (current) {
+      it->second = std::move(*next);
+    } else {
+      shard.map.try_emplace(key, std::move(*next));
+    }
+  }
+
+  size_type erase(const key_type &key) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.erase(key);
+  }
+
+  // Removes the element for key if pred(const mapped_type &) holds.
+  template <class Pred>
+  bool erase_if(const key_type &key, Pred &&pred) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end() ||
+        !std::forward<Pred>(pred)(static_cast<const mapped_type &>(
+            it->second))) {
+      return false;
+    }
+    shard.map.erase(it);
+    return true;
+  }
+
+  void clear() {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+      shards_[i].map.clear();
+    }
+  }
+
+  // methods for viewing the container
+  // Calls f(const key_type &, const mapped_type &) for every element,
+  // holding one shard's shared lock at a time. Each shard is seen in a
+  // consistent state, but writers may change other shards in between, so
+  // the walk as a whole is not a snapshot.
+  template <class F>
+  void for_each(F &&f) const {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+      for (const value_type &value : shards_[i].map) {
+        f(value.first, value.second);
+      }
+    }
+  }
+
+ private:
+  // Padded to a cache line so that locking one shard does not bounce the
+  // line holding its neighbour's mutex between cores.
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    shard_type map;
+  };
+
+  static size_type DefaultShardCount() {
+    return std::max<size_type>(16, 4 * std::thread::hardware_concurrency());
+  }
+
+  // Fibonacci hashing on the top bits; the shards' own tables take their
+  // probe positions and control bytes from a different mix of the hash,
+  // so all keys of one shard still spread over its table.
+  size_type ShardIndex(const key_type &key) const {
+    if (shard_bits_ == 0) return 0;
+    std::uint64_t hash = hasher_(key);
+    return static_cast<size_type>((hash * 0x9e3779b97f4a7c15ULL) >>
+                                  (64 - shard_bits_));
+  }
+
+  Shard &ShardFor(const key_type &key) { return shards_[ShardIndex(key)]; }
+
+  const Shard &ShardFor(const key_type &key) const {
+    return shards_[ShardIndex(key)];
+  }
+
+  size_type shard_count_ = 1;
+  int shard_bits_ = 0;
+  Hash hasher_;
+  std::unique_ptr<Shard[]> shards_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_CONCURRENT_MAP_H
@@ -1,6 +1,7 @@
 #ifndef SRC_S21_CONTAINERS_H
 #define SRC_S21_CONTAINERS_H
 
+#include "s21_allocator.h"
 #include "s21_list.h"
 #include "s21_map.h"
 #include "s21_queue.h"
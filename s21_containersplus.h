@@ -2,6 +2,18 @@
 #define SRC_S21_CONTAINERSPLUS_H
 
 #include "s21_array.h"
+#include "s21_btree_map.h"
+#include "s21_btree_multiset.h"
+#include "s21_btree_set.h"
+#include "s21_concurrent_map.h"
+#include "s21_counted_multiset.h"
+#include "s21_flat_map.h"
+#include "s21_flat_multiset.h"
+#include "s21_flat_set.h"
 #include "s21_multiset.h"
+#include "s21_persistent_map.h"
+#include "s21_set_algebra.h"
+#include "s21_unordered_map.h"
+#include "s21_unordered_set.h"
 
 #endif  // SRC_S21_CONTAINERSPLUS_H
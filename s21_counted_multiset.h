@@ -0,0 +1,324 @@
+#ifndef SRC_S21_COUNTED_MULTISET_H
+#define SRC_S21_COUNTED_MULTISET_H
+
+#include <memory_resource>
+
+#include "s21_tree.h"
+
+namespace s21 {
+// Multiset storing each distinct key once together with its number of
+// occurrences. Memory grows with the number of distinct keys, inserting or
+// erasing a duplicate only touches a counter, and iteration still visits
+// every occurrence, so it suits heavily duplicated data.
+template <typename T, class Compare = std::less<T>,
+          class Allocator = std::allocator<T>>
+class counted_multiset {
+ public:
+  // in-class type overrides
+  using key_type = T;
+  using value_type = T;
+  using reference = const T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+ private:
+  using entry_type = std::pair<T, size_type>;
+
+  // Transparent, so lookups compare a key against entry.first instead of
+  // copying it into an entry first.
+  struct EntryCompare {
+    using is_transparent = void;
+
+    bool operator()(const entry_type &x, const entry_type &y) const {
+      return compare(x.first, y.first);
+    }
+
+    bool operator()(const entry_type &x, const T &y) const {
+      return compare(x.first, y);
+    }
+
+    bool operator()(const T &x, const entry_type &y) const {
+      return compare(x, y.first);
+    }
+
+    Compare compare;
+  };
+
+  using entry_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<entry_type>;
+  using tree_type = BinaryTree<entry_type, EntryCompare, entry_allocator>;
+  using node_iterator = typename tree_type::iterator;
+
+ public:
+  // Walks the occurrences of a key before moving on to the next node. The
+  // position in a run is kept as the number of occurrences left from here
+  // to its end, so an erase earlier in the run does not move the iterator
+  // relative to what it still has to visit. One that leaves it past the
+  // new count pins it to the first occurrence.
+  struct counted_iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = counted_multiset::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    counted_iterator() = default;
+
+    // The first occurrence of node's key, or end() for the header.
+    explicit counted_iterator(node_iterator node)
+        : node_(node), left_(node.is_null() ? 0 : node->second) {}
+
+    counted_iterator(node_iterator node, size_type left)
+        : node_(node), left_(left) {}
+
+    reference operator*() const { return node_->first; }
+
+    pointer operator->() const { return &node_->first; }
+
+    counted_iterator &operator++() {
+      if (--Left() == 0) *this = counted_iterator(++node_);
+      return *this;
+    }
+
+    counted_iterator operator++(int) {
+      counted_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    counted_iterator &operator--() {
+      if (node_.is_null() || Left() == node_->second) {
+        --node_;
+        left_ = 1;
+      } else {
+        ++left_;
+      }
+      return *this;
+    }
+
+    counted_iterator operator--(int) {
+      counted_iterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    bool operator==(const counted_iterator &other) const {
+      return node_ == other.node_ &&
+             std::min(left_, Count()) == std::min(other.left_, Count());
+    }
+
+    bool operator!=(const counted_iterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class counted_multiset;
+
+    size_type Count() const { return node_.is_null() ? 0 : node_->second; }
+
+    size_type &Left() {
+      left_ = std::min(left_, Count());
+      return left_;
+    }
+
+    node_iterator node_;
+    size_type left_ = 0;
+  };
+
+  using iterator = counted_iterator;
+  using const_iterator = counted_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+
+  // main methods for interacting with the class
+  counted_multiset() {
+    size_ = 0;
+    root_ = new tree_type();
+  }
+
+  explicit counted_multiset(const Allocator &alloc) {
+    size_ = 0;
+    root_ = new tree_type(entry_allocator(alloc));
+  }
+
+  counted_multiset(std::initializer_list<value_type> const &items,
+                   const Allocator &alloc = Allocator())
+      : counted_multiset(items.begin(), items.end(), alloc) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  counted_multiset(InputIt first, InputIt last,
+                   const Allocator &alloc = Allocator())
+      : counted_multiset(alloc) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  counted_multiset(const counted_multiset &other) {
+    size_ = other.size_;
+    distinct_ = other.distinct_;
+    root_ = other.root_ ? new tree_type(*other.root_) : new tree_type();
+  }
+
+  counted_multiset(counted_multiset &&other) noexcept {
+    size_ = std::exchange(other.size_, 0);
+    distinct_ = std::exchange(other.distinct_, 0);
+    root_ = std::exchange(other.root_, nullptr);
+  }
+
+  counted_multiset &operator=(const counted_multiset &other) {
+    if (!other.root_) return *this;
+    size_ = 0;
+    *root_ = *other.root_;
+    size_ = other.size_;
+    distinct_ = other.distinct_;
+    return *this;
+  }
+
+  ~counted_multiset() {
+    size_ = 0;
+    delete root_;
+    root_ = nullptr;
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_type(root_->get_allocator());
+  }
+
+  // methods for iterating over class elements (access to iterators)
+  iterator begin() const { return iterator(root_->begin()); }
+
+  iterator end() const { return iterator(root_->end()); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  // Number of distinct keys, which is also the number of tree nodes.
+  size_type distinct_size() const noexcept { return distinct_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max();
+  }
+
+  // methods for modifying a container
+  void clear() {
+    root_->clear();
+    size_ = 0;
+    distinct_ = 0;
+  }
+
+  // Adds one occurrence; a key already present only has its counter
+  // bumped. Returns an iterator to the new, last, occurrence.
+  iterator insert(const_reference value) { return insert(value, 1); }
+
+  // Adds count occurrences of value at once.
+  iterator insert(const_reference value, size_type count) {
+    if (count == 0) return find(value);
+    std::pair<node_iterator, bool> ret =
+        root_->try_emplace(value, value, count);
+    if (ret.second) {
+      ++distinct_;
+    } else {
+      ret.first->second += count;
+    }
+    size_ += count;
+    return iterator(ret.first, 1);
+  }
+
+  // Removes all occurrences of value and returns how many there were.
+  size_type erase(const_reference value) {
+    node_iterator node = root_->find(value);
+    if (node.is_null()) return 0;
+    size_type count = node->second;
+    root_->erase(node);
+    size_ -= count;
+    --distinct_;
+    return count;
+  }
+
+  // Removes the single occurrence pos refers to and returns the iterator
+  // after it. Occurrences of a key are interchangeable, so the run just
+  // gets shorter: only pos is invalidated, iterators further on keep their
+  // place and erase(it++) works. Iterators before pos in the run may end
+  // up one occurrence closer to its start.
+  iterator erase(iterator pos) {
+    if (pos.node_.is_null()) return pos;
+    node_iterator node = pos.node_;
+    size_type left = pos.Left();
+    iterator next = left > 1 ? iterator(node, left - 1)
+                             : iterator(++node_iterator(node));
+    --size_;
+    if (--node->second == 0) {
+      root_->erase(node);
+      --distinct_;
+    }
+    return next;
+  }
+
+  // Adds other's occurrences key by key; other ends up empty.
+  void merge(counted_multiset &other) {
+    if (this == &other) return;
+    for (node_iterator node = other.root_->begin(); !node.is_null(); ++node) {
+      insert(node->first, node->second);
+    }
+    other.clear();
+  }
+
+  void swap(counted_multiset &other) {
+    std::swap(other.root_, this->root_);
+    std::swap(other.size_, this->size_);
+    std::swap(other.distinct_, this->distinct_);
+  }
+
+  // methods for viewing the container
+  size_type count(const_reference value) const {
+    node_iterator node = root_->find(value);
+    return node.is_null() ? 0 : node->second;
+  }
+
+  iterator lower_bound(const_reference key) const {
+    return iterator(root_->lower_bound(key));
+  }
+
+  iterator upper_bound(const_reference key) const {
+    return iterator(root_->upper_bound(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const_reference key) const {
+    node_iterator node = root_->find(key);
+    if (node.is_null()) {
+      iterator bound = lower_bound(key);
+      return std::make_pair(bound, bound);
+    }
+    iterator first(node);
+    return std::make_pair(first, iterator(++node));
+  }
+
+  iterator find(const_reference value) const {
+    node_iterator node = root_->find(value);
+    return node.is_null() ? end() : iterator(node);
+  }
+
+  bool contains(const_reference value) const {
+    return root_->contains(value);
+  }
+
+ private:
+  size_type size_;
+  size_type distinct_ = 0;
+  tree_type *root_;
+};
+
+namespace pmr {
+template <class T, class Compare = std::less<T>>
+using counted_multiset =
+    s21::counted_multiset<T, Compare, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_COUNTED_MULTISET_H
@@ -0,0 +1,473 @@
+#ifndef SRC_S21_FLAT_MAP_H
+#define SRC_S21_FLAT_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Map with the interface of s21::map kept in two sorted s21::vectors, one
+// of keys and one of mapped values, so a lookup binary-searches densely
+// packed keys without pulling the values into cache. See flat_set for the
+// trade-offs. Elements live in two arrays, so dereferencing an iterator
+// yields a pair of references rather than a reference to a pair.
+template <class Key, class T, class Compare = std::less<Key>>
+class flat_map {
+  template <bool Const>
+  class flat_iterator;
+
+ public:
+  // in-class type overrides
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = std::pair<const key_type &, mapped_type &>;
+  using const_reference = std::pair<const key_type &, const mapped_type &>;
+  using key_container_type = s21::vector<Key>;
+  using mapped_container_type = s21::vector<T>;
+  using iterator = flat_iterator<false>;
+  using const_iterator = flat_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = std::size_t;
+
+  // main methods for interacting with the class
+  flat_map() = default;
+
+  flat_map(std::initializer_list<value_type> const &items)
+      : flat_map(items.begin(), items.end()) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  flat_map(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  // methods for accessing the elements of the class
+  mapped_type &at(const key_type &key) { return FindByKey(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  mapped_type &at(const K &key) {
+    return FindByKey(key);
+  }
+
+  mapped_type &operator[](const key_type &key) {
+    size_type index = LowerIndex(key);
+    if (index == size() || comparator_(key, keys_[index])) {
+      InsertAt(index, key_type(key), mapped_type());
+    }
+    return values_[index];
+  }
+
+  // The underlying arrays, in key order.
+  const key_container_type &keys() const noexcept { return keys_; }
+
+  const mapped_container_type &values() const noexcept { return values_; }
+
+  // methods for iterating over class elements (access to iterator)
+  iterator begin() { return MakeIterator(0); }
+
+  iterator end() { return MakeIterator(size()); }
+
+  const_iterator begin() const { return MakeIterator(0); }
+
+  const_iterator end() const { return MakeIterator(size()); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return keys_.empty(); }
+
+  size_type size() const noexcept { return keys_.size(); }
+
+  size_type max_size() const noexcept {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+
+  void reserve(size_type size) {
+    keys_.reserve(size);
+    values_.reserve(size);
+  }
+
+  // methods for modifying a container
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+
+  // Replaces the contents with [first, last). Input already sorted by key
+  // is copied straight into place.
+  template <class InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    clear();
+    insert(first, last);
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return InsertUnique(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return InsertUnique(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return InsertUnique(key, obj);
+  }
+
+  // Sorts the new elements by key and merges them with the existing ones
+  // into fresh arrays in a single pass, instead of shifting both arrays
+  // once per element. Among equal keys the element already present, or
+  // else the first one in the range, wins.
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    s21::vector<std::pair<key_type, mapped_type>> items;
+    for (; first != last; ++first) {
+      items.push_back({first->first, first->second});
+    }
+    auto key_less = [this](const auto &x, const auto &y) {
+      return comparator_(x.first, y.first);
+    };
+    if (!std::is_sorted(items.begin(), items.end(), key_less)) {
+      std::stable_sort(items.begin(), items.end(), key_less);
+    }
+    flat_map merged;
+    merged.reserve(size() + items.size());
+    size_type i = 0;
+    for (auto item = items.begin(); i < size() || item != items.end();) {
+      if (item == items.end() ||
+          (i < size() && !comparator_(item->first, keys_[i]))) {
+        merged.Append(std::move(keys_[i]), std::move(values_[i]));
+        ++i;
+      } else if (merged.empty() ||
+                 comparator_(merged.keys_.back(), item->first)) {
+        merged.Append(std::move(item->first), std::move(item->second));
+        ++item;
+      } else {
+        ++item;
+      }
+    }
+    keys_.swap(merged.keys_);
+    values_.swap(merged.values_);
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj) {
+    std::pair<iterator, bool> ret = insert(key, obj);
+    if (!ret.second) values_[ret.first - begin()] = obj;
+    return ret;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return InsertUnique(value.first, std::move(value.second));
+  }
+
+  size_type erase(const key_type &key) { return EraseKey(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K &key) {
+    return EraseKey(key);
+  }
+
+  void erase(iterator pos) { erase(const_iterator(pos)); }
+
+  void erase(const_iterator pos) {
+    if (pos == end()) return;
+    EraseAt(pos - begin());
+  }
+
+  // Moves over the elements whose key is not present yet; the rest stay
+  // in other. Both sides are already sorted, so this is one merge pass.
+  void merge(flat_map &other) {
+    if (this == &other) return;
+    flat_map merged;
+    flat_map kept;
+    merged.reserve(size() + other.size());
+    size_type i = 0;
+    size_type j = 0;
+    while (i < size() || j < other.size()) {
+      if (j == other.size() ||
+          (i < size() && comparator_(keys_[i], other.keys_[j]))) {
+        merged.Append(std::move(keys_[i]), std::move(values_[i]));
+        ++i;
+      } else if (i == size() || comparator_(other.keys_[j], keys_[i])) {
+        merged.Append(std::move(other.keys_[j]), std::move(other.values_[j]));
+        ++j;
+      } else {
+        merged.Append(std::move(keys_[i]), std::move(values_[i]));
+        kept.Append(std::move(other.keys_[j]), std::move(other.values_[j]));
+        ++i;
+        ++j;
+      }
+    }
+    keys_.swap(merged.keys_);
+    values_.swap(merged.values_);
+    other.keys_.swap(kept.keys_);
+    other.values_.swap(kept.values_);
+  }
+
+  void swap(flat_map &other) {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+    std::swap(comparator_, other.comparator_);
+  }
+
+  // methods for viewing the container
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator find(const key_type &key) { return MakeIterator(FindIndex(key)); }
+
+  const_iterator find(const key_type &key) const {
+    return MakeIterator(FindIndex(key));
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K &key) {
+    return MakeIterator(FindIndex(key));
+  }
+
+  bool contains(const key_type &key) const { return FindIndex(key) != size(); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K &key) const {
+    return FindIndex(key) != size();
+  }
+
+  iterator lower_bound(const key_type &key) {
+    return MakeIterator(LowerIndex(key));
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K &key) {
+    return MakeIterator(LowerIndex(key));
+  }
+
+  iterator upper_bound(const key_type &key) {
+    return MakeIterator(UpperIndex(key));
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K &key) {
+    return MakeIterator(UpperIndex(key));
+  }
+
+ private:
+  // Walks both arrays in step; the pointer type stands in for operator->
+  // since there is no pair object to point at.
+  template <bool Const>
+  class flat_iterator {
+    using mapped_pointer = std::conditional_t<Const, const T *, T *>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = flat_map::value_type;
+    using reference = std::conditional_t<Const, flat_map::const_reference,
+                                         flat_map::reference>;
+
+    struct pointer {
+      reference *operator->() { return &ref; }
+
+      reference ref;
+    };
+
+    flat_iterator() = default;
+
+    template <bool C = Const, class = std::enable_if_t<C>>
+    flat_iterator(const flat_iterator<false> &other) noexcept
+        : key_(other.key_), value_(other.value_) {}
+
+    reference operator*() const { return reference(*key_, *value_); }
+
+    pointer operator->() const { return pointer{**this}; }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    flat_iterator &operator++() noexcept { return *this += 1; }
+
+    flat_iterator operator++(int) noexcept {
+      flat_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    flat_iterator &operator--() noexcept { return *this -= 1; }
+
+    flat_iterator operator--(int) noexcept {
+      flat_iterator temp = *this;
+      --(*this);
+      return temp;
+    }
+
+    flat_iterator &operator+=(difference_type n) noexcept {
+      key_ += n;
+      value_ += n;
+      return *this;
+    }
+
+    flat_iterator &operator-=(difference_type n) noexcept {
+      return *this += -n;
+    }
+
+    flat_iterator operator+(difference_type n) const noexcept {
+      flat_iterator temp = *this;
+      return temp += n;
+    }
+
+    flat_iterator operator-(difference_type n) const noexcept {
+      flat_iterator temp = *this;
+      return temp -= n;
+    }
+
+    difference_type operator-(const flat_iterator &other) const noexcept {
+      return key_ - other.key_;
+    }
+
+    bool operator==(const flat_iterator &other) const noexcept {
+      return key_ == other.key_;
+    }
+
+    bool operator!=(const flat_iterator &other) const noexcept {
+      return key_ != other.key_;
+    }
+
+    bool operator<(const flat_iterator &other) const noexcept {
+      return key_ < other.key_;
+    }
+
+    bool operator>(const flat_iterator &other) const noexcept {
+      return key_ > other.key_;
+    }
+
+    bool operator<=(const flat_iterator &other) const noexcept {
+      return key_ <= other.key_;
+    }
+
+    bool operator>=(const flat_iterator &other) const noexcept {
+      return key_ >= other.key_;
+    }
+
+   private:
+    friend class flat_map;
+    friend class flat_iterator<!Const>;
+
+    flat_iterator(const Key *key, mapped_pointer value) noexcept
+        : key_(key), value_(value) {}
+
+    const Key *key_ = nullptr;
+    mapped_pointer value_ = nullptr;
+  };
+
+  iterator MakeIterator(size_type index) {
+    return iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  const_iterator MakeIterator(size_type index) const {
+    return const_iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  template <class K>
+  size_type LowerIndex(const K &key) const {
+    return std::lower_bound(keys_.cbegin(), keys_.cend(), key, comparator_) -
+           keys_.cbegin();
+  }
+
+  template <class K>
+  size_type UpperIndex(const K &key) const {
+    return std::upper_bound(keys_.cbegin(), keys_.cend(), key, comparator_) -
+           keys_.cbegin();
+  }
+
+  // Index of the element with key, or size() when there is none.
+  template <class K>
+  size_type FindIndex(const K &key) const {
+    size_type index = LowerIndex(key);
+    if (index == size() || comparator_(key, keys_[index])) return size();
+    return index;
+  }
+
+  template <class K>
+  mapped_type &FindByKey(const K &key) {
+    size_type index = FindIndex(key);
+    if (index == size()) throw std::out_of_range("Key is not in the map");
+    return values_[index];
+  }
+
+  // Searches first, so the key and the mapped value are only copied when
+  // the key is new.
+  template <class M>
+  std::pair<iterator, bool> InsertUnique(const key_type &key, M &&obj) {
+    size_type index = LowerIndex(key);
+    if (index != size() && !comparator_(key, keys_[index])) {
+      return std::make_pair(MakeIterator(index), false);
+    }
+    InsertAt(index, key_type(key), mapped_type(std::forward<M>(obj)));
+    return std::make_pair(MakeIterator(index), true);
+  }
+
+  // Adds an element past the current last one; the caller keeps the keys
+  // in order.
+  void Append(key_type &&key, mapped_type &&obj) {
+    keys_.push_back(std::move(key));
+    try {
+      values_.push_back(std::move(obj));
+    } catch (...) {
+      keys_.pop_back();
+      throw;
+    }
+  }
+
+  // Appends to both arrays and rotates the new element into place.
+  void InsertAt(size_type index, key_type &&key, mapped_type &&obj) {
+    Append(std::move(key), std::move(obj));
+    std::rotate(keys_.begin() + index, keys_.end() - 1, keys_.end());
+    std::rotate(values_.begin() + index, values_.end() - 1, values_.end());
+  }
+
+  template <class K>
+  size_type EraseKey(const K &key) {
+    size_type index = FindIndex(key);
+    if (index == size()) return 0;
+    EraseAt(index);
+    return 1;
+  }
+
+  void EraseAt(size_type index) {
+    std::move(keys_.begin() + index + 1, keys_.end(), keys_.begin() + index);
+    std::move(values_.begin() + index + 1, values_.end(),
+              values_.begin() + index);
+    keys_.pop_back();
+    values_.pop_back();
+  }
+
+  Compare comparator_;
+  key_container_type keys_;
+  mapped_container_type values_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_FLAT_MAP_H
@@ -0,0 +1,220 @@
+#ifndef SRC_S21_FLAT_MULTISET_H
+#define SRC_S21_FLAT_MULTISET_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Multiset with the interface of s21::multiset kept as a sorted
+// s21::vector; see flat_set for the trade-offs. Equal elements stay in
+// insertion order.
+template <class T, class Compare = std::less<T>>
+class flat_multiset {
+ public:
+  // in-class type overrides
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using key_compare = Compare;
+  using container_type = s21::vector<T>;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+  using size_type = std::size_t;
+
+  // main methods for interacting with the class
+  flat_multiset() = default;
+
+  flat_multiset(std::initializer_list<value_type> const &items)
+      : flat_multiset(items.begin(), items.end()) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  flat_multiset(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  // methods for iterating over class elements (access to iterators)
+  iterator begin() const { return data_.cbegin(); }
+
+  iterator end() const { return data_.cend(); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return data_.empty(); }
+
+  size_type size() const noexcept { return data_.size(); }
+
+  size_type max_size() const noexcept { return data_.max_size(); }
+
+  void reserve(size_type size) { data_.reserve(size); }
+
+  // methods for modifying a container
+  void clear() { data_.clear(); }
+
+  // Replaces the contents with [first, last). Input already in order is
+  // copied straight into place.
+  template <class InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    data_.clear();
+    insert(first, last);
+  }
+
+  iterator insert(const_reference value) {
+    return InsertMulti(value_type(value));
+  }
+
+  iterator insert(value_type &&value) { return InsertMulti(std::move(value)); }
+
+  // Appends the new elements, sorts only them and merges them into the
+  // existing ones in a single pass, instead of shifting the array once per
+  // element.
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    size_type old_size = data_.size();
+    for (; first != last; ++first) data_.push_back(*first);
+    SortAndMerge(old_size);
+  }
+
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return InsertMulti(value_type(std::forward<Args>(args)...));
+  }
+
+  // Removes all elements equal to value.
+  size_type erase(const T &value) { return EraseKey(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K &key) {
+    return EraseKey(key);
+  }
+
+  void erase(iterator pos) {
+    if (pos == end()) return;
+    EraseRange(pos - begin(), 1);
+  }
+
+  // Moves all of other's elements over, after the equal ones already
+  // here; other ends up empty.
+  void merge(flat_multiset &other) {
+    if (this == &other) return;
+    size_type old_size = data_.size();
+    data_.reserve(old_size + other.data_.size());
+    for (T &value : other.data_) data_.push_back(std::move(value));
+    other.clear();
+    std::inplace_merge(data_.begin(), data_.begin() + old_size, data_.end(),
+                       comparator_);
+  }
+
+  void swap(flat_multiset &other) {
+    data_.swap(other.data_);
+    std::swap(comparator_, other.comparator_);
+  }
+
+  // methods for viewing the container
+  size_type count(const_reference value) const {
+    std::pair<iterator, iterator> range = equal_range(value);
+    return range.second - range.first;
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K &key) const {
+    std::pair<iterator, iterator> range = equal_range(key);
+    return range.second - range.first;
+  }
+
+  iterator find(const_reference value) const { return Find(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K &key) const {
+    return Find(key);
+  }
+
+  bool contains(const_reference value) const { return Find(value) != end(); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K &key) const {
+    return Find(key) != end();
+  }
+
+  iterator lower_bound(const_reference key) const {
+    return std::lower_bound(begin(), end(), key, comparator_);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K &key) const {
+    return std::lower_bound(begin(), end(), key, comparator_);
+  }
+
+  iterator upper_bound(const_reference key) const {
+    return std::upper_bound(begin(), end(), key, comparator_);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K &key) const {
+    return std::upper_bound(begin(), end(), key, comparator_);
+  }
+
+  std::pair<iterator, iterator> equal_range(const_reference key) const {
+    return std::equal_range(begin(), end(), key, comparator_);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return std::equal_range(begin(), end(), key, comparator_);
+  }
+
+ private:
+  template <class K>
+  iterator Find(const K &key) const {
+    iterator pos = std::lower_bound(begin(), end(), key, comparator_);
+    return pos != end() && !comparator_(key, *pos) ? pos : end();
+  }
+
+  iterator InsertMulti(value_type &&value) {
+    size_type index = upper_bound(value) - begin();
+    data_.push_back(std::move(value));
+    std::rotate(data_.begin() + index, data_.end() - 1, data_.end());
+    return begin() + index;
+  }
+
+  template <class K>
+  size_type EraseKey(const K &key) {
+    std::pair<iterator, iterator> range = equal_range(key);
+    size_type count = range.second - range.first;
+    EraseRange(range.first - begin(), count);
+    return count;
+  }
+
+  void EraseRange(size_type index, size_type count) {
+    std::move(data_.begin() + index + count, data_.end(),
+              data_.begin() + index);
+    for (; count > 0; --count) data_.pop_back();
+  }
+
+  // Sorts the elements from old_size on and merges them into the sorted
+  // prefix; both steps are stable, so equal elements keep insertion order.
+  void SortAndMerge(size_type old_size) {
+    T *middle = data_.begin() + old_size;
+    if (!std::is_sorted(middle, data_.end(), comparator_)) {
+      std::stable_sort(middle, data_.end(), comparator_);
+    }
+    std::inplace_merge(data_.begin(), middle, data_.end(), comparator_);
+  }
+
+  Compare comparator_;
+  container_type data_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_FLAT_MULTISET_H
@@ -0,0 +1,234 @@
+#ifndef SRC_S21_FLAT_SET_H
+#define SRC_S21_FLAT_SET_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "s21_tree.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Set with the interface of s21::set kept as a sorted s21::vector. Lookups
+// are binary searches over contiguous memory and there is no per-element
+// overhead, but a single insert or erase shifts the tail of the array, so
+// it suits tables that are built in bulk and then mostly read. Any insert
+// or erase invalidates iterators.
+template <class T, class Compare = std::less<T>>
+class flat_set {
+ public:
+  // in-class type overrides
+  using key_type = T;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using key_compare = Compare;
+  using container_type = s21::vector<T>;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+  using size_type = std::size_t;
+
+  // main methods for interacting with the class
+  flat_set() = default;
+
+  flat_set(std::initializer_list<value_type> const &items)
+      : flat_set(items.begin(), items.end()) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  flat_set(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  // methods for iterating over class elements (access to iterators)
+  iterator begin() const { return data_.cbegin(); }
+
+  iterator end() const { return data_.cend(); }
+
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return data_.empty(); }
+
+  size_type size() const noexcept { return data_.size(); }
+
+  size_type max_size() const noexcept { return data_.max_size(); }
+
+  void reserve(size_type size) { data_.reserve(size); }
+
+  // methods for modifying a container
+  void clear() { data_.clear(); }
+
+  // Replaces the contents with [first, last). Input already in order is
+  // copied straight into place.
+  template <class InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    data_.clear();
+    insert(first, last);
+  }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return InsertUnique(value_type(value));
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return InsertUnique(std::move(value));
+  }
+
+  // Appends the new elements, sorts only them and merges them into the
+  // existing ones in a single pass, instead of shifting the array once per
+  // element.
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    size_type old_size = data_.size();
+    for (; first != last; ++first) data_.push_back(*first);
+    SortAndMerge(old_size);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return InsertUnique(value_type(std::forward<Args>(args)...));
+  }
+
+  size_type erase(const T &value) { return EraseKey(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K &key) {
+    return EraseKey(key);
+  }
+
+  void erase(iterator pos) {
+    if (pos == end()) return;
+    EraseRange(pos - begin(), 1);
+  }
+
+  // Moves over the elements whose key is not present yet; the rest stay
+  // in other.
+  void merge(flat_set &other) {
+    if (this == &other) return;
+    container_type merged;
+    container_type kept;
+    merged.reserve(data_.size() + other.data_.size());
+    T *first1 = data_.begin();
+    T *first2 = other.data_.begin();
+    while (first1 != data_.end() || first2 != other.data_.end()) {
+      if (first2 == other.data_.end() ||
+          (first1 != data_.end() && comparator_(*first1, *first2))) {
+        merged.push_back(std::move(*first1++));
+      } else if (first1 == data_.end() || comparator_(*first2, *first1)) {
+        merged.push_back(std::move(*first2++));
+      } else {
+        merged.push_back(std::move(*first1++));
+        kept.push_back(std::move(*first2++));
+      }
+    }
+    data_.swap(merged);
+    other.data_.swap(kept);
+  }
+
+  void swap(flat_set &other) {
+    data_.swap(other.data_);
+    std::swap(comparator_, other.comparator_);
+  }
+
+  // methods for viewing the container
+  size_type count(const_reference value) const {
+    return contains(value) ? 1 : 0;
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  iterator find(const_reference value) const { return Find(value); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K &key) const {
+    return Find(key);
+  }
+
+  bool contains(const_reference value) const { return Find(value) != end(); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K &key) const {
+    return Find(key) != end();
+  }
+
+  iterator lower_bound(const_reference key) const {
+    return std::lower_bound(begin(), end(), key, comparator_);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K &key) const {
+    return std::lower_bound(begin(), end(), key, comparator_);
+  }
+
+  iterator upper_bound(const_reference key) const {
+    return std::upper_bound(begin(), end(), key, comparator_);
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K &key) const {
+    return std::upper_bound(begin(), end(), key, comparator_);
+  }
+
+ private:
+  template <class K>
+  iterator Find(const K &key) const {
+    iterator pos = std::lower_bound(begin(), end(), key, comparator_);
+    return pos != end() && !comparator_(key, *pos) ? pos : end();
+  }
+
+  std::pair<iterator, bool> InsertUnique(value_type &&value) {
+    iterator pos = lower_bound(value);
+    if (pos != end() && !comparator_(value, *pos)) {
+      return std::make_pair(pos, false);
+    }
+    size_type index = pos - begin();
+    data_.push_back(std::move(value));
+    std::rotate(data_.begin() + index, data_.end() - 1, data_.end());
+    return std::make_pair(begin() + index, true);
+  }
+
+  template <class K>
+  size_type EraseKey(const K &key) {
+    iterator pos = Find(key);
+    if (pos == end()) return 0;
+    EraseRange(pos - begin(), 1);
+    return 1;
+  }
+
+  void EraseRange(size_type index, size_type count) {
+    std::move(data_.begin() + index + count, data_.end(),
+              data_.begin() + index);
+    for (; count > 0; --count) data_.pop_back();
+  }
+
+  // Sorts the elements from old_size on and merges them into the sorted
+  // prefix. Equal elements keep their order, so after the merge the one
+  // that was present first leads its run and the others are dropped.
+  void SortAndMerge(size_type old_size) {
+    T *middle = data_.begin() + old_size;
+    if (!std::is_sorted(middle, data_.end(), comparator_)) {
+      std::stable_sort(middle, data_.end(), comparator_);
+    }
+    std::inplace_merge(data_.begin(), middle, data_.end(), comparator_);
+    T *last = std::unique(data_.begin(), data_.end(),
+                          [this](const T &x, const T &y) {
+                            return !comparator_(x, y);
+                          });
+    EraseRange(last - data_.begin(), data_.end() - last);
+  }
+
+  Compare comparator_;
+  container_type data_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_FLAT_SET_H
@@ -0,0 +1,654 @@
+#ifndef SRC_S21_HASH_TABLE_H
+#define SRC_S21_HASH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "s21_tree.h"
+
+namespace s21 {
+// Control byte of a hash table slot. Full slots store the low seven bits
+// of their element's hash, so a probe rejects almost every non-matching
+// slot without touching the slot array itself.
+using HashCtrl = std::int8_t;
+
+inline constexpr HashCtrl kCtrlEmpty = -128;
+inline constexpr HashCtrl kCtrlDeleted = -2;
+inline constexpr HashCtrl kCtrlSentinel = -1;
+
+// Sixteen control bytes examined at once: with SSE2 every query is a
+// compare and a movemask, elsewhere a loop the compiler can vectorize.
+// Bit i of a returned mask stands for the i-th byte of the group.
+struct HashGroup {
+  static constexpr int kWidth = 16;
+
+  explicit HashGroup(const HashCtrl *ctrl) noexcept {
+#ifdef __SSE2__
+    bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    std::memcpy(bytes, ctrl, kWidth);
+#endif
+  }
+
+  std::uint32_t Match(HashCtrl h2) const noexcept {
+#ifdef __SSE2__
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes)));
+#else
+    std::uint32_t mask = 0;
+    for (int i = 0; i < kWidth; ++i) mask |= std::uint32_t(bytes[i] == h2) << i;
+    return mask;
+#endif
+  }
+
+  std::uint32_t MatchEmpty() const noexcept { return Match(kCtrlEmpty); }
+
+  // Empty and deleted slots are the only ones below the sentinel.
+  std::uint32_t MatchEmptyOrDeleted() const noexcept {
+#ifdef __SSE2__
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kCtrlSentinel), bytes)));
+#else
+    std::uint32_t mask = 0;
+    for (int i = 0; i < kWidth; ++i) {
+      mask |= std::uint32_t(bytes[i] < kCtrlSentinel) << i;
+    }
+    return mask;
+#endif
+  }
+
+#ifdef __SSE2__
+  __m128i bytes;
+#else
+  HashCtrl bytes[kWidth];
+#endif
+};
+
+// Key extractors for HashTable: sets hash values themselves, maps the
+// first member of their pairs.
+struct HashIdentity {
+  template <class T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+struct HashSelectFirst {
+  template <class Pair>
+  const typename Pair::first_type &operator()(
+      const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+
+// Open-addressing hash table in the style of Swiss tables. Elements live
+// in one flat slot array next to an array of control bytes; a lookup
+// hashes once, then compares a group of control bytes at a time and only
+// looks at slots whose seven hash bits match. Groups are visited in a
+// triangular sequence that reaches every group of the power-of-two ring.
+// Map keys are stored mutable (see SlotType), so a rehash relocates
+// elements by move; it copies them instead when moving or hashing may
+// throw, and then a rehash that throws leaves the table as it was. Rehashing
+// invalidates iterators; erasing only invalidates the erased one.
+template <class Key, class Value, class KeyOf, class Hash, class KeyEqual,
+          class Allocator = std::allocator<Value>>
+class HashTable {
+  using slot_type = typename SlotType<Value>::type;
+  using value_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<slot_type>;
+  using value_traits = std::allocator_traits<value_allocator>;
+  using ctrl_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<HashCtrl>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+ public:
+  template <bool Const>
+  struct hash_iterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using iterator = hash_iterator<false>;
+  using const_iterator = hash_iterator<true>;
+
+  static constexpr int kWidth = HashGroup::kWidth;
+
+  HashTable() : HashTable(0) {}
+
+  explicit HashTable(size_type bucket_count, const Hash &hash = Hash(),
+                     const KeyEqual &equal = KeyEqual(),
+                     const Allocator &alloc = Allocator())
+      : hasher_(hash), key_equal_(equal), allocator_(alloc) {
+    if (bucket_count) Resize(NormalizeCapacity(bucket_count));
+  }
+
+  HashTable(const HashTable &other)
+      : hasher_(other.hasher_),
+        key_equal_(other.key_equal_),
+        max_load_factor_(other.max_load_factor_),
+        allocator_(value_traits::select_on_container_copy_construction(
+            other.allocator_)) {
+    try {
+      CopyFrom(other);
+    } catch (...) {
+      Destroy();
+      throw;
+    }
+  }
+
+  HashTable(HashTable &&other) noexcept
+      : ctrl_(std::exchange(other.ctrl_, EmptyGroup())),
+        slots_(std::exchange(other.slots_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        growth_left_(std::exchange(other.growth_left_, 0)),
+        hasher_(other.hasher_),
+        key_equal_(other.key_equal_),
+        max_load_factor_(other.max_load_factor_),
+        allocator_(std::move(other.allocator_)) {}
+
+  HashTable &operator=(const HashTable &other) {
+    if (this == &other) return *this;
+    clear();
+    hasher_ = other.hasher_;
+    key_equal_ = other.key_equal_;
+    max_load_factor_ = other.max_load_factor_;
+    CopyFrom(other);
+    return *this;
+  }
+
+  HashTable &operator=(HashTable &&other) {
+    if (this == &other) return *this;
+    Destroy();
+    hasher_ = other.hasher_;
+    key_equal_ = other.key_equal_;
+    max_load_factor_ = other.max_load_factor_;
+    if (value_traits::propagate_on_container_move_assignment::value ||
+        allocator_ == other.allocator_) {
+      if (value_traits::propagate_on_container_move_assignment::value) {
+        allocator_ = std::move(other.allocator_);
+      }
+      ctrl_ = std::exchange(other.ctrl_, EmptyGroup());
+      slots_ = std::exchange(other.slots_, nullptr);
+      capacity_ = std::exchange(other.capacity_, 0);
+      size_ = std::exchange(other.size_, 0);
+      growth_left_ = std::exchange(other.growth_left_, 0);
+    } else {
+      reserve(other.size_);
+      for (value_type &value : other) InsertNew(std::move(value));
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~HashTable() noexcept { Destroy(); }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(allocator_);
+  }
+
+  hasher hash_function() const { return hasher_; }
+
+  key_equal key_eq() const { return key_equal_; }
+
+  iterator begin() noexcept {
+    iterator it = MakeIterator(0);
+    it.SkipEmpty();
+    return it;
+  }
+
+  const_iterator begin() const noexcept {
+    const_iterator it = MakeIterator(0);
+    it.SkipEmpty();
+    return it;
+  }
+
+  iterator end() noexcept { return MakeIterator(capacity_); }
+
+  const_iterator end() const noexcept { return MakeIterator(capacity_); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+
+  const_iterator cend() const noexcept { return end(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type) / 2;
+  }
+
+  size_type bucket_count() const noexcept { return capacity_; }
+
+  float load_factor() const noexcept {
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f;
+  }
+
+  float max_load_factor() const noexcept { return max_load_factor_; }
+
+  // Rebuilds the table for the new factor, growing it when it is now too
+  // full. At least one slot always stays empty so that probes terminate.
+  void max_load_factor(float ml) {
+    if (!(ml > 0.0f)) throw std::invalid_argument("Load factor must be > 0");
+    max_load_factor_ = ml;
+    if (capacity_) Resize(std::max(capacity_, CapacityFor(size_)));
+  }
+
+  // Makes room for count elements without further rehashing.
+  void reserve(size_type count) {
+    if (count > CapacityToGrowth(capacity_)) Resize(CapacityFor(count));
+  }
+
+  // Rebuilds the table with at least bucket_count slots, and always
+  // enough for the current elements; this also drops deleted markers.
+  void rehash(size_type bucket_count) {
+    size_type capacity = std::max(bucket_count, CapacityFor(size_));
+    if (capacity == 0) {
+      Destroy();
+      return;
+    }
+    Resize(NormalizeCapacity(capacity));
+  }
+
+  void clear() noexcept {
+    if (capacity_ == 0) return;
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (IsFull(ctrl_[i])) value_traits::destroy(allocator_, slots_ + i);
+    }
+    ResetCtrl();
+    size_ = 0;
+  }
+
+  void swap(HashTable &other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hasher_, other.hasher_);
+    std::swap(key_equal_, other.key_equal_);
+    std::swap(max_load_factor_, other.max_load_factor_);
+    if (value_traits::propagate_on_container_swap::value) {
+      std::swap(allocator_, other.allocator_);
+    }
+  }
+
+  // Lookups on a const table hand out const_iterators.
+  template <class K>
+  iterator find(const K &key) {
+    size_type index = Find(key, Mix(hasher_(key)));
+    return index == capacity_ ? end() : MakeIterator(index);
+  }
+
+  template <class K>
+  const_iterator find(const K &key) const {
+    size_type index = Find(key, Mix(hasher_(key)));
+    return index == capacity_ ? end() : MakeIterator(index);
+  }
+
+  template <class K>
+  bool contains(const K &key) const {
+    return Find(key, Mix(hasher_(key))) != capacity_;
+  }
+
+  // Constructs an element from args unless one with key is present; the
+  // element must carry key. Nothing is constructed for a present key.
+  template <class K, class... Args>
+  std::pair<iterator, bool> emplace_unique(const K &key, Args &&...args) {
+    std::size_t hash = Mix(hasher_(key));
+    size_type index = Find(key, hash);
+    if (index != capacity_) return std::make_pair(MakeIterator(index), false);
+    index = FindFirstNonFull(hash);
+    if (NeedsGrowth(index)) {
+      // Growing moves every element and frees the old slots, which args
+      // may refer into (as in m.try_emplace(k, m.at(other))), so the
+      // element is built before the table grows.
+      slot_type value(std::forward<Args>(args)...);
+      index = Grow(hash);
+      value_traits::construct(allocator_, slots_ + index, std::move(value));
+    } else {
+      value_traits::construct(allocator_, slots_ + index,
+                              std::forward<Args>(args)...);
+    }
+    CommitInsert(index, hash);
+    return std::make_pair(MakeIterator(index), true);
+  }
+
+  void erase(const_iterator pos) noexcept {
+    if (pos == cend()) return;
+    EraseAt(static_cast<size_type>(pos.ctrl_ - ctrl_));
+  }
+
+  template <class K>
+  size_type erase_key(const K &key) {
+    size_type index = Find(key, Mix(hasher_(key)));
+    if (index == capacity_) return 0;
+    EraseAt(index);
+    return 1;
+  }
+
+ private:
+  static bool IsFull(HashCtrl ctrl) noexcept { return ctrl >= 0; }
+
+  static HashCtrl H2(std::size_t hash) noexcept {
+    return static_cast<HashCtrl>(hash & 0x7F);
+  }
+
+  static std::size_t H1(std::size_t hash) noexcept { return hash >> 7; }
+
+  // Spreads weak hashes such as the identity hash of std::hash<int> over
+  // all bits, since probing starts from the high bits and H2 takes the
+  // low ones.
+  static std::size_t Mix(std::size_t hash) noexcept {
+    std::uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+  }
+
+  // The control bytes of an empty table: lookups find the sentinel and an
+  // empty byte and stop without any special casing.
+  static HashCtrl *EmptyGroup() noexcept {
+    alignas(16) static constexpr HashCtrl kEmptyGroup[kWidth] = {
+        kCtrlSentinel, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+        kCtrlEmpty,    kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+        kCtrlEmpty,    kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+        kCtrlEmpty,    kCtrlEmpty, kCtrlEmpty, kCtrlEmpty};
+    return const_cast<HashCtrl *>(kEmptyGroup);
+  }
+
+  // Capacities are 2^k - 1 so that capacity_ doubles as the probe mask;
+  // the sentinel takes the remaining position of the ring.
+  static size_type NormalizeCapacity(size_type n) noexcept {
+    size_type capacity = kWidth - 1;
+    while (capacity < n) capacity = capacity * 2 + 1;
+    return capacity;
+  }
+
+  size_type CapacityToGrowth(size_type capacity) const noexcept {
+    if (capacity == 0) return 0;
+    size_type growth = static_cast<size_type>(capacity * max_load_factor_);
+    return std::min(growth, capacity - 1);
+  }
+
+  size_type CapacityFor(size_type count) const noexcept {
+    if (count == 0) return 0;
+    size_type capacity = NormalizeCapacity(
+        static_cast<size_type>(count / max_load_factor_) + 1);
+    while (CapacityToGrowth(capacity) < count) capacity = capacity * 2 + 1;
+    return capacity;
+  }
+
+  // Slots are handed out as Value; see SlotType. Const members convert
+  // the result to a const_iterator before returning it.
+  iterator MakeIterator(size_type index) const noexcept {
+    return iterator(ctrl_ + index, reinterpret_cast<Value *>(slots_ + index));
+  }
+
+  // The first kWidth - 1 control bytes are mirrored after the sentinel,
+  // so a group can be loaded at any position without wrapping around.
+  void SetCtrl(size_type index, HashCtrl ctrl) noexcept {
+    ctrl_[index] = ctrl;
+    ctrl_[((index - (kWidth - 1)) & capacity_) + (kWidth - 1)] = ctrl;
+  }
+
+  void ResetCtrl() noexcept {
+    std::memset(ctrl_, kCtrlEmpty, capacity_ + kWidth);
+    ctrl_[capacity_] = kCtrlSentinel;
+    growth_left_ = CapacityToGrowth(capacity_);
+  }
+
+  template <class K>
+  size_type Find(const K &key, std::size_t hash) const {
+    size_type offset = H1(hash) & capacity_;
+    for (size_type step = kWidth;; step += kWidth) {
+      HashGroup group(ctrl_ + offset);
+      for (std::uint32_t mask = group.Match(H2(hash)); mask;
+           mask &= mask - 1) {
+        size_type index = (offset + __builtin_ctz(mask)) & capacity_;
+        if (key_equal_(key, KeyOf()(slots_[index]))) return index;
+      }
+      if (group.MatchEmpty()) return capacity_;
+      offset = (offset + step) & capacity_;
+    }
+  }
+
+  size_type FindFirstNonFull(std::size_t hash) const noexcept {
+    size_type offset = H1(hash) & capacity_;
+    for (size_type step = kWidth;; step += kWidth) {
+      std::uint32_t mask = HashGroup(ctrl_ + offset).MatchEmptyOrDeleted();
+      if (mask) return (offset + __builtin_ctz(mask)) & capacity_;
+      offset = (offset + step) & capacity_;
+    }
+  }
+
+  // Picks the slot for a new element, growing first when no empty slot
+  // may be used up. A table clogged with deleted markers is rebuilt at the
+  // same size instead of doubling.
+  size_type PrepareInsert(std::size_t hash) {
+    size_type index = FindFirstNonFull(hash);
+    return NeedsGrowth(index) ? Grow(hash) : index;
+  }
+
+  // Whether taking the free slot at index needs the table rebuilt first.
+  bool NeedsGrowth(size_type index) const noexcept {
+    return growth_left_ == 0 && ctrl_[index] != kCtrlDeleted;
+  }
+
+  // Rebuilds the table and returns the slot for a new element with hash.
+  size_type Grow(std::size_t hash) {
+    if (capacity_ && size_ < CapacityToGrowth(capacity_) / 2) {
+      Resize(capacity_);
+    } else {
+      Resize(std::max(capacity_ * 2 + 1, CapacityFor(size_ + 1)));
+    }
+    return FindFirstNonFull(hash);
+  }
+
+  void CommitInsert(size_type index, std::size_t hash) noexcept {
+    if (ctrl_[index] == kCtrlEmpty) --growth_left_;
+    SetCtrl(index, H2(hash));
+    ++size_;
+  }
+
+  // Inserts an element known to be absent.
+  template <class V>
+  void InsertNew(V &&value) {
+    std::size_t hash = Mix(hasher_(KeyOf()(value)));
+    size_type index = PrepareInsert(hash);
+    value_traits::construct(allocator_, slots_ + index, std::forward<V>(value));
+    CommitInsert(index, hash);
+  }
+
+  // A slot with fewer than kWidth occupied neighbours in a row can never
+  // have been skipped over by a probe, since every group covering it has
+  // an empty slot too, so it becomes empty again instead of deleted.
+  void EraseAt(size_type index) noexcept {
+    value_traits::destroy(allocator_, slots_ + index);
+    --size_;
+    std::uint32_t empty_before =
+        HashGroup(ctrl_ + ((index - kWidth) & capacity_)).MatchEmpty();
+    std::uint32_t empty_after = HashGroup(ctrl_ + index).MatchEmpty();
+    if (empty_before && empty_after &&
+        __builtin_ctz(empty_after) + (__builtin_clz(empty_before) - 16) <
+            kWidth) {
+      SetCtrl(index, kCtrlEmpty);
+      ++growth_left_;
+    } else {
+      SetCtrl(index, kCtrlDeleted);
+    }
+  }
+
+  // Elements are moved to the new slots when neither hashing nor the move
+  // can throw; otherwise they are copied, so an exception leaves the old
+  // slots untouched. Elements that cannot be copied are moved regardless.
+  static constexpr bool kMoveOnRehash =
+      (std::is_nothrow_move_constructible<slot_type>::value &&
+       noexcept(std::declval<const Hash &>()(std::declval<const Key &>()))) ||
+      !std::is_copy_constructible<slot_type>::value;
+
+  // Rehashes into new arrays and frees the old ones only once every
+  // element has been placed; on an exception the new arrays are dropped
+  // and the table is restored.
+  void Resize(size_type capacity) {
+    HashCtrl *old_ctrl = ctrl_;
+    slot_type *old_slots = slots_;
+    size_type old_capacity = capacity_;
+    size_type old_growth_left = growth_left_;
+    ctrl_allocator ctrl_alloc(allocator_);
+    HashCtrl *ctrl = ctrl_traits::allocate(ctrl_alloc, capacity + kWidth);
+    try {
+      slots_ = value_traits::allocate(allocator_, capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(ctrl_alloc, ctrl, capacity + kWidth);
+      throw;
+    }
+    ctrl_ = ctrl;
+    capacity_ = capacity;
+    ResetCtrl();
+    try {
+      for (size_type i = 0; i < old_capacity; ++i) {
+        if (!IsFull(old_ctrl[i])) continue;
+        std::size_t hash = Mix(hasher_(KeyOf()(old_slots[i])));
+        size_type index = FindFirstNonFull(hash);
+        if constexpr (kMoveOnRehash) {
+          value_traits::construct(allocator_, slots_ + index,
+                                  std::move(old_slots[i]));
+        } else {
+          value_traits::construct(allocator_, slots_ + index,
+                                  std::as_const(old_slots[i]));
+        }
+        SetCtrl(index, H2(hash));
+      }
+    } catch (...) {
+      for (size_type i = 0; i < capacity_; ++i) {
+        if (IsFull(ctrl_[i])) value_traits::destroy(allocator_, slots_ + i);
+      }
+      ctrl_traits::deallocate(ctrl_alloc, ctrl_, capacity_ + kWidth);
+      value_traits::deallocate(allocator_, slots_, capacity_);
+      ctrl_ = old_ctrl;
+      slots_ = old_slots;
+      capacity_ = old_capacity;
+      growth_left_ = old_growth_left;
+      throw;
+    }
+    growth_left_ -= size_;
+    if (old_capacity) {
+      for (size_type i = 0; i < old_capacity; ++i) {
+        if (IsFull(old_ctrl[i])) {
+          value_traits::destroy(allocator_, old_slots + i);
+        }
+      }
+      ctrl_traits::deallocate(ctrl_alloc, old_ctrl, old_capacity + kWidth);
+      value_traits::deallocate(allocator_, old_slots, old_capacity);
+    }
+  }
+
+  void CopyFrom(const HashTable &other) {
+    reserve(other.size_);
+    for (const value_type &value : other) InsertNew(value);
+  }
+
+  void Destroy() noexcept {
+    if (capacity_ == 0) return;
+    clear();
+    ctrl_allocator ctrl_alloc(allocator_);
+    ctrl_traits::deallocate(ctrl_alloc, ctrl_, capacity_ + kWidth);
+    value_traits::deallocate(allocator_, slots_, capacity_);
+    ctrl_ = EmptyGroup();
+    slots_ = nullptr;
+    capacity_ = 0;
+    growth_left_ = 0;
+  }
+
+  HashCtrl *ctrl_ = EmptyGroup();
+  slot_type *slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  size_type growth_left_ = 0;
+  Hash hasher_;
+  KeyEqual key_equal_;
+  float max_load_factor_ = 0.875f;
+  value_allocator allocator_;
+
+ public:
+  // Forward iterator over the control bytes; the sentinel stops the scan
+  // at end().
+  template <bool Const>
+  struct hash_iterator {
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = HashTable::value_type;
+    using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+    using reference = std::conditional_t<Const, const value_type &,
+                                         value_type &>;
+
+    hash_iterator() = default;
+
+    template <bool C = Const, class = std::enable_if_t<C>>
+    hash_iterator(const hash_iterator<false> &other) noexcept
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    reference operator*() const { return *slot_; }
+
+    pointer operator->() const { return slot_; }
+
+    hash_iterator &operator++() noexcept {
+      ++ctrl_;
+      ++slot_;
+      SkipEmpty();
+      return *this;
+    }
+
+    hash_iterator operator++(int) noexcept {
+      hash_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const hash_iterator &other) const noexcept {
+      return ctrl_ == other.ctrl_;
+    }
+
+    bool operator!=(const hash_iterator &other) const noexcept {
+      return ctrl_ != other.ctrl_;
+    }
+
+   private:
+    friend class HashTable;
+    friend struct hash_iterator<!Const>;
+
+    hash_iterator(HashCtrl *ctrl, Value *slot) noexcept
+        : ctrl_(ctrl), slot_(slot) {}
+
+    void SkipEmpty() noexcept {
+      while (*ctrl_ < kCtrlSentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    HashCtrl *ctrl_ = nullptr;
+    Value *slot_ = nullptr;
+  };
+};
+}  // namespace s21
+
+#endif  // SRC_S21_HASH_TABLE_H
@@ -1,21 +1,46 @@
 #ifndef SRC_S21_MAP_H
 #define SRC_S21_MAP_H
 
+#include <memory_resource>
+#include <tuple>
+
 #include "s21_tree.h"
 #include "s21_vector.h"
 
 namespace s21 {
+// Orders map elements by key. It is transparent: elements and keys of any
+// type comparable with Key can be mixed freely, so lookups by key never
+// build an element, and elements are compared in place instead of being
+// converted to T first.
 template <class T>
 class MapCompare {
  public:
   using value_type = T;
-  bool operator()(const value_type& x, const value_type& y) const {
-    return x.first < y.first;
+  using is_transparent = void;
+
+  template <class X, class Y>
+  bool operator()(const X& x, const Y& y) const { return KeyOf(x) < KeyOf(y); }
+
+ private:
+  using key_type = std::remove_const_t<typename T::first_type>;
+  using mapped_type = typename T::second_type;
+
+  static const key_type& KeyOf(
+      const std::pair<const key_type, mapped_type>& value) {
+    return value.first;
+  }
+
+  static const key_type& KeyOf(const std::pair<key_type, mapped_type>& value) {
+    return value.first;
   }
+
+  template <class K>
+  static const K& KeyOf(const K& key) { return key; }
 };
 
 template <typename Key, typename T,
-          class Compare = MapCompare<std::pair<Key, T>>>
+          class Compare = MapCompare<std::pair<Key, T>>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
 class map {
  public:
   // in-class type overrides
@@ -25,29 +50,42 @@ class map {
   using key_compare = Compare;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename BinaryTree<value_type, key_compare>::iterator;
-  using const_iterator =
-      typename BinaryTree<value_type, key_compare>::const_iterator;
+  using tree_type = BinaryTree<value_type, key_compare, Allocator>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = typename tree_type::reverse_iterator;
+  using const_reverse_iterator = typename tree_type::const_reverse_iterator;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using node_type = typename tree_type::node_handle;
+  using insert_return_type = typename tree_type::insert_return_type;
 
   // main methods for interacting with the class
   map() {
     size_ = 0;
-    root_ = new BinaryTree<value_type, key_compare>(root);
+    root_ = new tree_type();
   }
 
-  map(std::initializer_list<value_type> const& items) {
+  explicit map(const Allocator& alloc) {
     size_ = 0;
-    root_ = new BinaryTree<value_type, key_compare>(root);
-    for (value_type c : items) {
-      insert(c);
-    }
+    root_ = new tree_type(alloc);
+  }
+
+  map(std::initializer_list<value_type> const& items,
+      const Allocator& alloc = Allocator()) {
+    root_ = new tree_type(alloc);
+    size_ = root_->assign_sorted(items.begin(), items.end());
+  }
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  map(InputIt first, InputIt last, const Allocator& alloc = Allocator()) {
+    root_ = new tree_type(alloc);
+    size_ = root_->assign_sorted(first, last);
   }
 
   map(const map& other) {
-    size_ = 0;
-    root_ = new BinaryTree<value_type, key_compare>(root);
-    *this = other;
+    size_ = other.size_;
+    root_ = other.root_ ? new tree_type(*other.root_) : new tree_type();
   }
 
   map(map&& other) noexcept {
@@ -63,19 +101,27 @@ class map {
 
   map& operator=(const map& other) {
     if (!other.root_) return *this;
-    size_ = other.size_;
+    size_ = 0;
     *root_ = *other.root_;
+    size_ = other.size_;
     return *this;
   }
 
+  allocator_type get_allocator() const { return root_->get_allocator(); }
+
   // methods for accessing the elements of the class
-  mapped_type& at(const key_type& key) { return FindByKey(key); }
+  mapped_type& at(const key_type& key) { return FindByKey(LookupKey(key)); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  mapped_type& at(const K& key) { return FindByKey(key); }
 
+  // A present key costs one descent and constructs nothing.
   mapped_type& operator[](const key_type& key) {
-    std::pair<iterator, bool> it_bool = root_->insert({key, {}});
-    iterator it = it_bool.first;
-    if (it_bool.second == true) size_++;
-    return (*it).second;
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type& operator[](key_type&& key) {
+    return try_emplace(std::move(key)).first->second;
   }
 
   // methods for iterating over class elements (access to iterator)
@@ -87,6 +133,14 @@ class map {
 
   const_iterator end() const { return root_->cend(); }
 
+  reverse_iterator rbegin() { return root_->rbegin(); }
+
+  reverse_iterator rend() { return root_->rend(); }
+
+  const_reverse_iterator rbegin() const { return root_->crbegin(); }
+
+  const_reverse_iterator rend() const { return root_->crend(); }
+
   // methods for accessing the container capacity information
   bool empty() { return size_ == 0; }
 
@@ -94,25 +148,27 @@ class map {
 
   // methods for modifying a container
   void merge(map& other) {
-    s21::vector<key_type> values_to_erase;
-    if (other.empty()) return;
-    for (iterator it = other.begin(); it != other.end(); it++) {
-      iterator i = find(*it);
-      if (i == end()) {
-        insert(*it);
-        values_to_erase.push_back((*it).first);
-      }
-    }
-    while (!values_to_erase.empty()) {
-      other.erase(values_to_erase.back());
-      values_to_erase.pop_back();
-    }
+    size_type moved = root_->Merge(*other.root_, true, size_, other.size_);
+    size_ += moved;
+    other.size_ -= moved;
   }
 
   iterator find(const_reference value) { return root_->find(value); }
 
+  iterator find(const key_type& key) { return root_->find(LookupKey(key)); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K& key) { return root_->find(key); }
+
   size_type erase(const Key& key) {
-    size_type count = root_->del({key, {}});
+    size_type count = root_->del(LookupKey(key));
+    size_ -= count;
+    return count;
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K& key) {
+    size_type count = root_->del(key);
     size_ -= count;
     return count;
   }
@@ -122,15 +178,60 @@ class map {
     size_ -= count;
   }
 
+  // Removes [first, last) in O(log n + k) by cutting the range out of the
+  // tree instead of erasing element by element.
+  iterator erase(iterator first, iterator last) {
+    size_ -= root_->erase_range(first, last);
+    return last;
+  }
+
+  // Moves the elements whose key is not less than key into the returned
+  // map by splitting the tree, O(log n) relinking with nothing copied.
+  map split(const key_type& key) {
+    map upper(get_allocator());
+    upper.size_ = root_->split(root_->lower_bound(LookupKey(key)),
+                               *upper.root_, size_);
+    size_ -= upper.size_;
+    return upper;
+  }
+
+  // Moves all of other in by joining the trees in O(log n). The keys of
+  // other must all be less, or all be greater, than the ones here;
+  // otherwise std::invalid_argument is thrown and nothing moves.
+  void join(map& other) {
+    root_->join(*other.root_, true);
+    size_ += std::exchange(other.size_, 0);
+  }
+
+  // Moves the elements with keys in [lo, hi) into the returned map: two
+  // splits and a join, O(log n) relinking.
+  map extract_range(const key_type& lo, const key_type& hi) {
+    map middle = split(lo);
+    map tail = middle.split(hi);
+    join(tail);
+    return middle;
+  }
+
   void clear() {
-    delete root_;
-    root_ = new BinaryTree<value_type, key_compare>(root);
+    root_->clear();
     size_ = 0;
   }
 
+  // Replaces the contents with [first, last). Input already sorted by key
+  // is built into a balanced tree in linear time.
+  template <class InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    size_ = root_->assign_sorted(first, last);
+  }
+
   size_type count(const value_type value) { return root_->count_unique(value); }
 
-  size_type count(const Key& key) { return root_->count_unique({key, {}}); }
+  size_type count(const Key& key) {
+    return root_->count_unique(LookupKey(key));
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K& key) { return root_->count_unique(key); }
 
   std::pair<iterator, bool> insert(const_reference value) {
     std::pair<iterator, bool> ret = root_->insert(value);
@@ -138,9 +239,87 @@ class map {
     return ret;
   }
 
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> ret = root_->insert(std::move(value));
+    if (ret.second) ++size_;
+    return ret;
+  }
+
+  // Inserts value as close before hint as the order allows, amortized O(1)
+  // when hint is right (such as the previous insertion, or end() for
+  // ascending keys); otherwise it costs an ordinary insert.
+  iterator insert(iterator hint, const_reference value) {
+    std::pair<iterator, bool> ret = root_->insert_hint(hint, value, true);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  iterator insert(iterator hint, value_type&& value) {
+    std::pair<iterator, bool> ret =
+        root_->insert_hint(hint, std::move(value), true);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Node handles: extract() takes an element out together with its node
+  // and insert() links that node into another map, so elements move
+  // between maps, and can be changed on the way, with no allocation or
+  // copy.
+  node_type extract(iterator pos) {
+    node_type node = root_->extract(pos);
+    if (node) --size_;
+    return node;
+  }
+
+  node_type extract(const key_type& key) {
+    return extract(find(key));
+  }
+
+  insert_return_type insert(node_type&& node) {
+    std::pair<iterator, bool> ret = root_->insert_node(node, true);
+    if (ret.second) ++size_;
+    return {ret.first, ret.second, std::move(node)};
+  }
+
+  iterator insert(iterator hint, node_type&& node) {
+    std::pair<iterator, bool> ret = root_->insert_node(node, true, hint);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Constructs the element in its node from args, as std::map does.
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args&&... args) {
+    std::pair<iterator, bool> ret =
+        root_->emplace_hint(hint, true, std::forward<Args>(args)...);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Inserts each argument as an element of its own, constructed in place
+  // from it.
   template <typename... Args>
   s21::vector<std::pair<iterator, bool>> emplace(Args&&... args) {
-    return root_->Emplace(std::forward<Args>(args)...);
+    s21::vector<std::pair<iterator, bool>> ret =
+        root_->Emplace(true, std::forward<Args>(args)...);
+    for (const auto& item : ret) size_ += item.second;
+    return ret;
+  }
+
+  // Inserts an element with key and a mapped value constructed from args
+  // when key is absent; when it is present nothing is constructed, moved
+  // from or copied. One descent either way.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return TryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                      std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return TryEmplace(key, std::piecewise_construct,
+                      std::forward_as_tuple(std::move(key)),
+                      std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
   std::pair<iterator, bool> insert(const key_type& key,
@@ -151,29 +330,101 @@ class map {
 
   std::pair<iterator, bool> insert_or_assign(const key_type& k,
                                              const mapped_type& obj) {
-    value_type value = std::make_pair(k, obj);
-    std::pair<iterator, bool> ret = insert(value);
-    if (ret.second == false) {
-      (*(ret.first)).second = obj;
-    }
+    std::pair<iterator, bool> ret = try_emplace(k, obj);
+    if (!ret.second) ret.first->second = obj;
     return ret;
   }
 
+  // Calls fn(value) on the mapped value of key, value-initialized and
+  // inserted first when the key is absent, all in a single descent.
+  // Returns the value. fn must not modify the map.
+  template <class F>
+  mapped_type& upsert(const key_type& key, F&& fn) {
+    auto update = [&fn](value_type& value, bool) {
+      fn(value.second);
+      return true;
+    };
+    return Compute(key, update).first->second;
+  }
+
+  // General read-modify-write in a single descent: fn(value, existed)
+  // gets the mapped value of key, or a value-initialized one when the key
+  // is absent, and returns whether the entry should stay. A new entry
+  // fn declines is never linked into the tree; an existing one is erased.
+  // Returns the entry, or end() if there is none afterwards. fn must not
+  // modify the map.
+  template <class F>
+  iterator compute(const key_type& key, F&& fn) {
+    auto update = [&fn](value_type& value, bool existed) -> bool {
+      return fn(value.second, existed);
+    };
+    return Compute(key, update).first;
+  }
+
   // methods for viewing the container
-  bool contains(const Key& key) { return root_->contains({key, {}}); }
+  bool contains(const Key& key) { return root_->contains(LookupKey(key)); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K& key) { return root_->contains(key); }
+
+  iterator lower_bound(const Key& key) {
+    return root_->lower_bound(LookupKey(key));
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K& key) { return root_->lower_bound(key); }
+
+  iterator upper_bound(const Key& key) {
+    return root_->upper_bound(LookupKey(key));
+  }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K& key) { return root_->upper_bound(key); }
 
  private:
-  mapped_type& FindByKey(const key_type& key) {
-    auto pair = std::make_pair(key, 0);
-    auto res = root_->find(pair);
+  // What a key lookup hands the tree: the key itself when Compare is
+  // transparent, otherwise an element built around it.
+  static decltype(auto) LookupKey(const key_type& key) {
+    if constexpr (IsTransparent<Compare>::value) {
+      return (key);
+    } else {
+      return value_type(key, mapped_type());
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> TryEmplace(const key_type& key, Args&&... args) {
+    std::pair<iterator, bool> ret =
+        root_->try_emplace(LookupKey(key), std::forward<Args>(args)...);
+    if (ret.second) ++size_;
+    return ret;
+  }
+
+  template <class F>
+  std::pair<iterator, int> Compute(const key_type& key, F& update) {
+    std::pair<iterator, int> ret =
+        root_->compute(LookupKey(key), update, std::piecewise_construct,
+                       std::forward_as_tuple(key), std::tuple<>());
+    size_ += ret.second;
+    return ret;
+  }
+
+  template <class K>
+  mapped_type& FindByKey(const K& key) {
+    auto res = root_->find(key);
     if (res == end()) throw std::out_of_range("Key is not in the map");
     return ((*res).second);
   }
 
-  static constexpr bool root = true;
   size_type size_;
-  BinaryTree<value_type, key_compare>* root_;
+  tree_type* root_;
 };
+
+namespace pmr {
+template <class Key, class T, class Compare = MapCompare<std::pair<Key, T>>>
+using map = s21::map<Key, T, Compare,
+                     std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_MAP_H
@@ -1,11 +1,14 @@
-#ifndef SRC_S21_SET_H
-#define SRC_S21_SET_H
+#ifndef SRC_S21_MULTISET_H
+#define SRC_S21_MULTISET_H
+
+#include <memory_resource>
 
 #include "s21_tree.h"
 #include "s21_vector.h"
 
 namespace s21 {
-template <typename T, class Compare = std::less<T>>
+template <typename T, class Compare = std::less<T>,
+          class Allocator = std::allocator<T>, bool OrderStatistics = false>
 class multiset {
  public:
   // in-class type overrides
@@ -13,26 +16,41 @@ class multiset {
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
-  using iterator = typename BinaryTree<T, Compare>::iterator;
-  using const_iterator = typename BinaryTree<T, Compare>::const_iterator;
+  using tree_type = BinaryTree<T, Compare, Allocator, OrderStatistics>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = typename tree_type::reverse_iterator;
+  using const_reverse_iterator = typename tree_type::const_reverse_iterator;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using node_type = typename tree_type::node_handle;
 
   // main methods for interacting with the class
   multiset() {
     size_ = 0;
-    root_ = new BinaryTree<T, Compare>(root);
+    root_ = new tree_type();
   }
 
-  multiset(std::initializer_list<value_type> const &items) {
+  explicit multiset(const Allocator &alloc) {
     size_ = 0;
-    root_ = new BinaryTree<T, Compare>(root);
-    for (const value_type &item : items) insert(item);
+    root_ = new tree_type(alloc);
+  }
+
+  multiset(std::initializer_list<value_type> const &items,
+           const Allocator &alloc = Allocator()) {
+    root_ = new tree_type(alloc);
+    size_ = root_->assign_sorted_non_unique(items.begin(), items.end());
+  }
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  multiset(InputIt first, InputIt last, const Allocator &alloc = Allocator()) {
+    root_ = new tree_type(alloc);
+    size_ = root_->assign_sorted_non_unique(first, last);
   }
 
   multiset(const multiset &other) {
-    size_ = 0;
-    root_ = new BinaryTree<T, Compare>(root);
-    *this = other;
+    size_ = other.size_;
+    root_ = other.root_ ? new tree_type(*other.root_) : new tree_type();
   }
 
   multiset(multiset &&other) noexcept {
@@ -42,8 +60,9 @@ class multiset {
 
   multiset &operator=(const multiset &other) {
     if (!other.root_) return *this;
-    size_ = other.size_;
+    size_ = 0;
     *root_ = *other.root_;
+    size_ = other.size_;
     return *this;
   }
 
@@ -53,6 +72,8 @@ class multiset {
     root_ = nullptr;
   }
 
+  allocator_type get_allocator() const { return root_->get_allocator(); }
+
   // methods for iterating over class elements (access to iterators)
   iterator begin() { return root_->begin(); }
 
@@ -62,6 +83,14 @@ class multiset {
 
   const_iterator end() const { return root_->cend(); }
 
+  reverse_iterator rbegin() { return root_->rbegin(); }
+
+  reverse_iterator rend() { return root_->rend(); }
+
+  const_reverse_iterator rbegin() const { return root_->crbegin(); }
+
+  const_reverse_iterator rend() const { return root_->crend(); }
+
   // methods for accessing the container capacity information
   bool empty() const noexcept { return size_ == 0; }
 
@@ -69,29 +98,99 @@ class multiset {
 
   size_type max_size() const noexcept {
     return std::numeric_limits<size_type>::max() /
-           sizeof(BinaryTree<T, Compare>) / 2;
+           sizeof(tree_type) / 2;
   }
 
   // methods for modifying a container
   void clear() {
-    delete root_;
-    root_ = new BinaryTree<T, Compare>(root);
+    root_->clear();
     size_ = 0;
   }
 
+  // Replaces the contents with [first, last). Input already in order is
+  // built into a balanced tree in linear time.
+  template <class InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    size_ = root_->assign_sorted_non_unique(first, last);
+  }
+
   std::pair<iterator, bool> insert(const_reference value) {
     std::pair<iterator, bool> ret = root_->insert_non_unique(value);
     if (ret.second == true) size_++;
     return ret;
   }
 
+  std::pair<iterator, bool> insert(value_type &&value) {
+    std::pair<iterator, bool> ret = root_->insert_non_unique(std::move(value));
+    if (ret.second) ++size_;
+    return ret;
+  }
+
+  // Inserts value as close before hint as the order allows, amortized O(1)
+  // when hint is right (such as the previous insertion, or end() for
+  // ascending input); otherwise it costs an ordinary insert.
+  iterator insert(iterator hint, const_reference value) {
+    std::pair<iterator, bool> ret = root_->insert_hint(hint, value, false);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  iterator insert(iterator hint, value_type &&value) {
+    std::pair<iterator, bool> ret =
+        root_->insert_hint(hint, std::move(value), false);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Node handles: extract() takes an element out together with its node
+  // and insert() links that node into another multiset, so elements move
+  // between multisets, and can be changed on the way, with no allocation or
+  // copy.
+  node_type extract(iterator pos) {
+    node_type node = root_->extract(pos);
+    if (node) --size_;
+    return node;
+  }
+
+  node_type extract(const_reference key) {
+    iterator pos = lower_bound(key);
+    return pos != upper_bound(key) ? extract(pos) : node_type();
+  }
+
+  iterator insert(node_type &&node) {
+    std::pair<iterator, bool> ret = root_->insert_node(node, false);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  iterator insert(iterator hint, node_type &&node) {
+    std::pair<iterator, bool> ret = root_->insert_node(node, false, hint);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Constructs the element in its node from args.
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    std::pair<iterator, bool> ret =
+        root_->emplace_hint(hint, false, std::forward<Args>(args)...);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Inserts each argument as an element of its own, constructed in place
+  // from it.
   template <typename... Args>
   s21::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
-    return root_->Emplace(std::forward<Args>(args)...);
+    s21::vector<std::pair<iterator, bool>> ret =
+        root_->Emplace(false, std::forward<Args>(args)...);
+    for (const auto &item : ret) size_ += item.second;
+    return ret;
   }
 
+  // Removes all elements equal to value.
   size_type erase(const T &value) {
-    size_type count = root_->del(value);
+    size_type count = root_->del_non_unique(value);
     size_ -= count;
     return count;
   }
@@ -101,9 +200,53 @@ class multiset {
     size_ -= count;
   }
 
+  // Removes [first, last) in O(log n + k) by cutting the range out of the
+  // tree instead of erasing element by element.
+  iterator erase(iterator first, iterator last) {
+    size_ -= root_->erase_range(first, last);
+    return last;
+  }
+
+  // Moves the elements not less than key into the returned multiset by
+  // splitting the tree, O(log n) relinking with nothing copied.
+  multiset split(const_reference key) {
+    multiset upper(get_allocator());
+    upper.size_ = root_->split(root_->lower_bound(key), *upper.root_, size_);
+    size_ -= upper.size_;
+    return upper;
+  }
+
+  // Moves all of other in by joining the trees in O(log n). The elements
+  // of other must all be not less, or all be not greater, than the ones
+  // here; otherwise std::invalid_argument is thrown and nothing moves.
+  void join(multiset &other) {
+    root_->join(*other.root_, false);
+    size_ += std::exchange(other.size_, 0);
+  }
+
+  // Moves the elements in [lo, hi) into the returned multiset: two splits
+  // and a join, O(log n) relinking.
+  multiset extract_range(const_reference lo, const_reference hi) {
+    multiset middle = split(lo);
+    multiset tail = middle.split(hi);
+    join(tail);
+    return middle;
+  }
+
   void merge(multiset &other) {
-    root_->Merge(other.root_);
-    size_ += other.size_;
+    size_type moved = root_->Merge(*other.root_, false, size_, other.size_);
+    size_ += moved;
+    other.size_ -= moved;
+  }
+
+  // Replaces the contents with op applied to a and b, either of which may
+  // be this multiset; see BinaryTree::AssignSetOperation. The free functions
+  // in s21_set_algebra.h can also split large inputs across threads.
+  void assign_set_operation(SetOperation op, const multiset &a,
+                            const multiset &b) {
+    multiset result(get_allocator());
+    result.size_ = result.root_->AssignSetOperation(op, *a.root_, *b.root_);
+    swap(result);
   }
 
   void swap(multiset &other) {
@@ -112,7 +255,7 @@ class multiset {
   }
 
   // methods for viewing the container
-  size_type count(const value_type value) { return root_->count(value); }
+  size_type count(const_reference value) { return root_->count(value); }
 
   iterator lower_bound(const value_type &key) {
     return root_->lower_bound(key);
@@ -123,18 +266,34 @@ class multiset {
   }
 
   std::pair<iterator, iterator> equal_range(const value_type &key) {
-    return std::make_pair(root_->lower_bound(key), root_->upper_bound(key));
+    return root_->equal_range(key);
   }
 
   iterator find(const_reference value) { return root_->find(value); }
 
   bool contains(const T value) const { return root_->contains(value); }
 
+  // Order statistics in O(log n), available with OrderStatistics set.
+  size_type rank(const_reference key) const { return root_->rank(key); }
+
+  iterator select(size_type index) { return root_->select(index); }
+
+  size_type count_range(const_reference lo, const_reference hi) const {
+    return root_->count_range(lo, hi);
+  }
+
  private:
-  static constexpr bool root = true;
+  friend class ParallelSetOperation<tree_type>;
+
   size_type size_;
-  BinaryTree<T, Compare> *root_;
+  tree_type *root_;
 };
+
+namespace pmr {
+template <class T, class Compare = std::less<T>>
+using multiset =
+    s21::multiset<T, Compare, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
-#endif  // SRC_S21_SET_H
+#endif  // SRC_S21_MULTISET_H
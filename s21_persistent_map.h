@@ -0,0 +1,139 @@
+#ifndef SRC_S21_PERSISTENT_MAP_H
+#define SRC_S21_PERSISTENT_MAP_H
+
+#include <memory_resource>
+#include <stdexcept>
+
+#include "s21_persistent_tree.h"
+#include "s21_tree.h"
+
+namespace s21 {
+// Map whose versions share structure; see PersistentTree. snapshot() (or
+// a plain copy) is O(1) and the result never changes, so a writer can keep
+// modifying the map while readers walk snapshots without any locking, and
+// each old version is freed once its last snapshot is gone. Readers may
+// take their snapshots themselves, from any thread, during writes.
+// Elements are immutable in place: they are only reachable through const
+// iterators, and modifications report whether they changed the key set
+// instead of returning an iterator. Compare orders keys, as in std::map.
+template <typename Key, typename T, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class persistent_map {
+ public:
+  // in-class type overrides
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using tree_type = PersistentTree<key_type, value_type, PersistentSelectFirst,
+                                   Compare, Allocator>;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  // main methods for interacting with the class
+  persistent_map() = default;
+
+  explicit persistent_map(const Allocator& alloc) : tree_(alloc) {}
+
+  persistent_map(std::initializer_list<value_type> const& items,
+                 const Allocator& alloc = Allocator())
+      : persistent_map(items.begin(), items.end(), alloc) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  persistent_map(InputIt first, InputIt last,
+                 const Allocator& alloc = Allocator())
+      : tree_(alloc) {
+    for (; first != last; ++first) tree_.insert_unique(*first);
+  }
+
+  allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+  // The current version, unaffected by later changes to this map. Safe to
+  // call while another thread writes the map.
+  persistent_map snapshot() const noexcept { return *this; }
+
+  // methods for accessing the elements of the class
+  const mapped_type& at(const key_type& key) const {
+    const_iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("Key is not in the map");
+    return it->second;
+  }
+
+  // methods for iterating over class elements (access to iterator)
+  const_iterator begin() const noexcept { return tree_.begin(); }
+
+  const_iterator end() const noexcept { return tree_.end(); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return tree_.empty(); }
+
+  size_type size() const noexcept { return tree_.size(); }
+
+  size_type max_size() const noexcept { return tree_.max_size(); }
+
+  // methods for modifying a container
+  void clear() noexcept { tree_.clear(); }
+
+  // Returns whether the element was inserted.
+  bool insert(const_reference value) { return tree_.insert_unique(value); }
+
+  bool insert(value_type&& value) {
+    return tree_.insert_unique(std::move(value));
+  }
+
+  bool insert(const key_type& key, const mapped_type& obj) {
+    return tree_.insert_unique(value_type(key, obj));
+  }
+
+  // Returns true if the element was inserted, false if it was assigned.
+  bool insert_or_assign(const key_type& key, const mapped_type& obj) {
+    return tree_.insert_or_replace(value_type(key, obj));
+  }
+
+  size_type erase(const key_type& key) { return tree_.erase_unique(key); }
+
+  void swap(persistent_map& other) noexcept { tree_.swap(other.tree_); }
+
+  // methods for viewing the container
+  size_type count(const key_type& key) const {
+    return tree_.contains(key) ? 1 : 0;
+  }
+
+  const_iterator find(const key_type& key) const { return tree_.find(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  const_iterator find(const K& key) const {
+    return tree_.find(key);
+  }
+
+  bool contains(const key_type& key) const { return tree_.contains(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K& key) const {
+    return tree_.contains(key);
+  }
+
+  const_iterator lower_bound(const key_type& key) const {
+    return tree_.lower_bound(key);
+  }
+
+  const_iterator upper_bound(const key_type& key) const {
+    return tree_.upper_bound(key);
+  }
+
+ private:
+  tree_type tree_;
+};
+
+namespace pmr {
+template <typename Key, typename T, class Compare = std::less<Key>>
+using persistent_map = s21::persistent_map<
+    Key, T, Compare, std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_PERSISTENT_MAP_H
@@ -0,0 +1,499 @@
+#ifndef SRC_S21_PERSISTENT_TREE_H
+#define SRC_S21_PERSISTENT_TREE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace s21 {
+// Key extractors for PersistentTree: sets order values themselves, maps
+// order the first member of their pairs.
+struct PersistentIdentity {
+  template <class T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+struct PersistentSelectFirst {
+  template <class Pair>
+  const typename Pair::first_type &operator()(
+      const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+
+// AVL tree whose nodes are never modified once built. An insert or erase
+// copies the O(log n) nodes on the path from the root to the change and
+// shares every other subtree with the previous version, so copying a tree
+// is O(1): the copy is a snapshot that later changes to either side do not
+// affect. Nodes carry an atomic reference count and are freed by whichever
+// version drops the last reference, on whatever thread that happens.
+// Reading a version needs no locks even while another thread modifies a
+// copy of it. Copying is safe from any thread while one writer modifies
+// the source: writers build the new version aside and only swap the root
+// under a short lock, which copies take too, so a copy never retains a
+// root that is being freed. Apart from copies, a single tree object is not
+// safe for concurrent use, like any other container. Copies share nodes,
+// so they keep the source allocator rather than asking for a new one.
+template <class Key, class Value, class KeyOf, class Compare,
+          class Allocator = std::allocator<Value>>
+class PersistentTree {
+  struct Node;
+
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+ public:
+  class const_iterator;
+
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using iterator = const_iterator;
+
+  // An AVL tree of height 64 holds more than 10^13 nodes, far beyond any
+  // address space the nodes could fit in, so iterator paths never
+  // overflow.
+  static constexpr int kMaxHeight = 64;
+
+  PersistentTree() : PersistentTree(Allocator()) {}
+
+  explicit PersistentTree(const Allocator &alloc) noexcept
+      : allocator_(alloc) {}
+
+  PersistentTree(const PersistentTree &other) noexcept
+      : PersistentTree(other,
+                       std::unique_lock<std::mutex>(other.publish_mutex_)) {}
+
+  PersistentTree(PersistentTree &&other) noexcept
+      : PersistentTree(std::move(other),
+                       std::unique_lock<std::mutex>(other.publish_mutex_)) {}
+
+  // Assignment swaps the new version in, so the old one is released with
+  // the allocator that built it.
+  PersistentTree &operator=(const PersistentTree &other) noexcept {
+    PersistentTree copy(other);
+    swap(copy);
+    return *this;
+  }
+
+  PersistentTree &operator=(PersistentTree &&other) noexcept {
+    if (this == &other) return *this;
+    PersistentTree moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  ~PersistentTree() noexcept { Release(root_); }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(allocator_);
+  }
+
+  const_iterator begin() const noexcept {
+    const_iterator it;
+    it.PushLeft(root_);
+    return it;
+  }
+
+  const_iterator end() const noexcept { return const_iterator(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  size_type size() const noexcept { return size_; }
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  // Number of levels, 0 for an empty tree.
+  int height() const noexcept { return Height(root_); }
+
+  void clear() noexcept { Publish(nullptr, 0); }
+
+  void swap(PersistentTree &other) noexcept {
+    if (this == &other) return;
+    std::scoped_lock lock(publish_mutex_, other.publish_mutex_);
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(comparator_, other.comparator_);
+    std::swap(allocator_, other.allocator_);
+  }
+
+  // The path kept by the iterator holds the found node and every ancestor
+  // whose left subtree contains it: exactly the nodes still to be visited.
+  template <class K>
+  const_iterator find(const K &key) const noexcept {
+    const_iterator it;
+    for (const Node *node = root_; node;) {
+      if (comparator_(key, KeyOf()(node->value))) {
+        it.path_[it.depth_++] = node;
+        node = node->left;
+      } else if (comparator_(KeyOf()(node->value), key)) {
+        node = node->right;
+      } else {
+        it.path_[it.depth_++] = node;
+        return it;
+      }
+    }
+    return end();
+  }
+
+  template <class K>
+  bool contains(const K &key) const noexcept {
+    for (const Node *node = root_; node;) {
+      if (comparator_(key, KeyOf()(node->value))) {
+        node = node->left;
+      } else if (comparator_(KeyOf()(node->value), key)) {
+        node = node->right;
+      } else {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class K>
+  const_iterator lower_bound(const K &key) const noexcept {
+    const_iterator it;
+    for (const Node *node = root_; node;) {
+      if (comparator_(KeyOf()(node->value), key)) {
+        node = node->right;
+      } else {
+        it.path_[it.depth_++] = node;
+        node = node->left;
+      }
+    }
+    return it;
+  }
+
+  template <class K>
+  const_iterator upper_bound(const K &key) const noexcept {
+    const_iterator it;
+    for (const Node *node = root_; node;) {
+      if (comparator_(key, KeyOf()(node->value))) {
+        it.path_[it.depth_++] = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return it;
+  }
+
+  // Inserts value unless an equal key is present; returns whether it did.
+  template <class V>
+  bool insert_unique(V &&value) {
+    return InsertRoot(std::forward<V>(value), false);
+  }
+
+  // Inserts value, replacing the element with an equal key if there is
+  // one; returns whether the key was new.
+  template <class V>
+  bool insert_or_replace(V &&value) {
+    return InsertRoot(std::forward<V>(value), true);
+  }
+
+  template <class K>
+  size_type erase_unique(const K &key) {
+    bool found = false;
+    Node *root = Erase(root_, key, found);
+    if (!found) return 0;
+    Publish(root, size_ - 1);
+    return 1;
+  }
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = PersistentTree::value_type;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    const_iterator() = default;
+
+    // Only the live part of the path is copied.
+    const_iterator(const const_iterator &other) noexcept
+        : depth_(other.depth_) {
+      std::copy_n(other.path_.begin(), depth_, path_.begin());
+    }
+
+    const_iterator &operator=(const const_iterator &other) noexcept {
+      depth_ = other.depth_;
+      std::copy_n(other.path_.begin(), depth_, path_.begin());
+      return *this;
+    }
+
+    reference operator*() const { return path_[depth_ - 1]->value; }
+
+    pointer operator->() const { return &path_[depth_ - 1]->value; }
+
+    const_iterator &operator++() noexcept {
+      PushLeft(path_[--depth_]->right);
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const const_iterator &other) const noexcept {
+      return depth_ == other.depth_ &&
+             (depth_ == 0 || path_[depth_ - 1] == other.path_[depth_ - 1]);
+    }
+
+    bool operator!=(const const_iterator &other) const noexcept {
+      return !(*this == other);
+    }
+
+   private:
+    friend class PersistentTree;
+
+    void PushLeft(const Node *node) noexcept {
+      for (; node; node = node->left) path_[depth_++] = node;
+    }
+
+    std::array<const Node *, kMaxHeight> path_;
+    int depth_ = 0;
+  };
+
+ private:
+  // Copies and moves read other under the lock its writers publish under;
+  // the lock is held until the members are initialized.
+  PersistentTree(const PersistentTree &other,
+                 std::unique_lock<std::mutex>) noexcept
+      : root_(Retain(other.root_)),
+        size_(other.size_),
+        comparator_(other.comparator_),
+        allocator_(other.allocator_) {}
+
+  PersistentTree(PersistentTree &&other,
+                 std::unique_lock<std::mutex>) noexcept
+      : root_(std::exchange(other.root_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        comparator_(other.comparator_),
+        allocator_(other.allocator_) {}
+
+  struct Node {
+    template <class... Args>
+    Node(Node *l, Node *r, Args &&...args)
+        : left(l),
+          right(r),
+          height(1 + std::max(Height(l), Height(r))),
+          value(std::forward<Args>(args)...) {}
+
+    std::atomic<std::size_t> refs{1};
+    Node *const left;
+    Node *const right;
+    const int height;
+    const Value value;
+  };
+
+  static int Height(const Node *node) noexcept {
+    return node ? node->height : 0;
+  }
+
+  static Node *Retain(Node *node) noexcept {
+    if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+    return node;
+  }
+
+  // The release ordering makes every write to a node happen before the
+  // thread that drops the last reference destroys it.
+  void Release(Node *node) noexcept {
+    while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Node *left = node->left;
+      Node *right = node->right;
+      node_traits::destroy(allocator_, node);
+      node_traits::deallocate(allocator_, node, 1);
+      Release(left);
+      node = right;
+    }
+  }
+
+  // Makes root, whose reference this tree takes over, the current version
+  // and drops the previous one. Only the swap happens under the lock that
+  // copies retain the root under; the old version is released after it,
+  // so a copy made meanwhile has either retained it or sees the new root.
+  void Publish(Node *root, size_type size) noexcept {
+    Node *old = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(publish_mutex_);
+      old = std::exchange(root_, root);
+      size_ = size;
+    }
+    Release(old);
+  }
+
+  // Builds a node owning the references to left and right it is given.
+  // They are released if construction throws, so callers hand them over
+  // unconditionally.
+  template <class... Args>
+  Node *MakeNode(Node *left, Node *right, Args &&...args) {
+    Node *node = nullptr;
+    try {
+      node = node_traits::allocate(allocator_, 1);
+      node_traits::construct(allocator_, node, left, right,
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      if (node) node_traits::deallocate(allocator_, node, 1);
+      Release(left);
+      Release(right);
+      throw;
+    }
+    return node;
+  }
+
+  // A new node holding value over left and right, rotated back into AVL
+  // shape when the heights differ by two. Takes ownership of left and
+  // right; the rotated-away node is released, the rest of it reused.
+  Node *Balance(Node *left, const Value &value, Node *right) {
+    if (Height(left) > Height(right) + 1) {
+      try {
+        Node *root = RotateRight(left, value, right);
+        Release(left);
+        return root;
+      } catch (...) {
+        Release(left);
+        throw;
+      }
+    }
+    if (Height(right) > Height(left) + 1) {
+      try {
+        Node *root = RotateLeft(left, value, right);
+        Release(right);
+        return root;
+      } catch (...) {
+        Release(right);
+        throw;
+      }
+    }
+    return MakeNode(left, right, value);
+  }
+
+  // Left is too tall; consumes right only.
+  Node *RotateRight(Node *left, const Value &value, Node *right) {
+    if (Height(left->left) >= Height(left->right)) {
+      Node *lower = MakeNode(Retain(left->right), right, value);
+      return MakeNode(Retain(left->left), lower, left->value);
+    }
+    Node *pivot = left->right;
+    Node *upper = MakeNode(Retain(pivot->right), right, value);
+    Node *lower = nullptr;
+    try {
+      lower = MakeNode(Retain(left->left), Retain(pivot->left), left->value);
+    } catch (...) {
+      Release(upper);
+      throw;
+    }
+    return MakeNode(lower, upper, pivot->value);
+  }
+
+  // Mirror image of RotateRight; consumes left only.
+  Node *RotateLeft(Node *left, const Value &value, Node *right) {
+    if (Height(right->right) >= Height(right->left)) {
+      Node *lower = MakeNode(left, Retain(right->left), value);
+      return MakeNode(lower, Retain(right->right), right->value);
+    }
+    Node *pivot = right->left;
+    Node *upper = MakeNode(left, Retain(pivot->left), value);
+    Node *lower = nullptr;
+    try {
+      lower =
+          MakeNode(Retain(pivot->right), Retain(right->right), right->value);
+    } catch (...) {
+      Release(upper);
+      throw;
+    }
+    return MakeNode(upper, lower, pivot->value);
+  }
+
+  template <class V>
+  bool InsertRoot(V &&value, bool replace) {
+    bool inserted = false;
+    Node *root = Insert(root_, std::forward<V>(value), replace, inserted);
+    if (!root) return false;
+    Publish(root, inserted ? size_ + 1 : size_);
+    return inserted;
+  }
+
+  // The copy of node's subtree with value added, or null when nothing
+  // changes because the key is present and replace is off.
+  template <class V>
+  Node *Insert(Node *node, V &&value, bool replace, bool &inserted) {
+    if (!node) {
+      inserted = true;
+      return MakeNode(nullptr, nullptr, std::forward<V>(value));
+    }
+    const key_type &key = KeyOf()(value);
+    if (comparator_(key, KeyOf()(node->value))) {
+      Node *left = Insert(node->left, std::forward<V>(value), replace,
+                          inserted);
+      if (!left) return nullptr;
+      return Balance(left, node->value, Retain(node->right));
+    }
+    if (comparator_(KeyOf()(node->value), key)) {
+      Node *right = Insert(node->right, std::forward<V>(value), replace,
+                           inserted);
+      if (!right) return nullptr;
+      return Balance(Retain(node->left), node->value, right);
+    }
+    if (!replace) return nullptr;
+    return MakeNode(Retain(node->left), Retain(node->right),
+                    std::forward<V>(value));
+  }
+
+  // The copy of node's subtree without key; found tells whether there was
+  // anything to remove, since an emptied subtree is null too.
+  template <class K>
+  Node *Erase(Node *node, const K &key, bool &found) {
+    if (!node) return nullptr;
+    if (comparator_(key, KeyOf()(node->value))) {
+      Node *left = Erase(node->left, key, found);
+      if (!found) return nullptr;
+      return Balance(left, node->value, Retain(node->right));
+    }
+    if (comparator_(KeyOf()(node->value), key)) {
+      Node *right = Erase(node->right, key, found);
+      if (!found) return nullptr;
+      return Balance(Retain(node->left), node->value, right);
+    }
+    found = true;
+    if (!node->left) return Retain(node->right);
+    if (!node->right) return Retain(node->left);
+    const Node *successor = node->right;
+    while (successor->left) successor = successor->left;
+    Node *right = EraseMin(node->right);
+    return Balance(Retain(node->left), successor->value, right);
+  }
+
+  Node *EraseMin(Node *node) {
+    if (!node->left) return Retain(node->right);
+    Node *left = EraseMin(node->left);
+    return Balance(left, node->value, Retain(node->right));
+  }
+
+  Node *root_ = nullptr;
+  size_type size_ = 0;
+  Compare comparator_;
+  node_allocator allocator_;
+  // Guards root_ and size_ against a copy made while the tree is written.
+  // Readers of the tree's own contents never take it.
+  mutable std::mutex publish_mutex_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_PERSISTENT_TREE_H
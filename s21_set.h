@@ -1,11 +1,14 @@
 #ifndef SRC_S21_SET_H
 #define SRC_S21_SET_H
 
+#include <memory_resource>
+
 #include "s21_tree.h"
 #include "s21_vector.h"
 
 namespace s21 {
-template <class T, class Compare = std::less<T>>
+template <class T, class Compare = std::less<T>,
+          class Allocator = std::allocator<T>, bool OrderStatistics = false>
 class set {
  public:
   // in-class type overrides
@@ -13,26 +16,42 @@ class set {
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
-  using iterator = typename BinaryTree<T, Compare>::iterator;
-  using const_iterator = typename BinaryTree<T, Compare>::const_iterator;
+  using tree_type = BinaryTree<T, Compare, Allocator, OrderStatistics>;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using reverse_iterator = typename tree_type::reverse_iterator;
+  using const_reverse_iterator = typename tree_type::const_reverse_iterator;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using node_type = typename tree_type::node_handle;
+  using insert_return_type = typename tree_type::insert_return_type;
 
   // main methods for interacting with the class
   set() {
     size_ = 0;
-    root_ = new BinaryTree<T, Compare>(root);
+    root_ = new tree_type();
   }
 
-  set(std::initializer_list<value_type> const &items) {
+  explicit set(const Allocator &alloc) {
     size_ = 0;
-    root_ = new BinaryTree<T, Compare>(root);
-    for (const value_type &item : items) insert(item);
+    root_ = new tree_type(alloc);
+  }
+
+  set(std::initializer_list<value_type> const &items,
+      const Allocator &alloc = Allocator()) {
+    root_ = new tree_type(alloc);
+    size_ = root_->assign_sorted(items.begin(), items.end());
+  }
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  set(InputIt first, InputIt last, const Allocator &alloc = Allocator()) {
+    root_ = new tree_type(alloc);
+    size_ = root_->assign_sorted(first, last);
   }
 
   set(const set &other) {
-    size_ = 0;
-    root_ = new BinaryTree<T, Compare>(root);
-    *this = other;
+    size_ = other.size_;
+    root_ = other.root_ ? new tree_type(*other.root_) : new tree_type();
   }
 
   set(set &&other) noexcept {
@@ -42,8 +61,9 @@ class set {
 
   set &operator=(const set &other) {
     if (!other.root_) return *this;
-    size_ = other.size_;
+    size_ = 0;
     *root_ = *other.root_;
+    size_ = other.size_;
     return *this;
   }
 
@@ -53,6 +73,8 @@ class set {
     root_ = nullptr;
   }
 
+  allocator_type get_allocator() const { return root_->get_allocator(); }
+
   // methods for iterating over class elements (access to iterators)
   iterator begin() { return root_->begin(); }
 
@@ -62,6 +84,14 @@ class set {
 
   const_iterator end() const { return root_->cend(); }
 
+  reverse_iterator rbegin() { return root_->rbegin(); }
+
+  reverse_iterator rend() { return root_->rend(); }
+
+  const_reverse_iterator rbegin() const { return root_->crbegin(); }
+
+  const_reverse_iterator rend() const { return root_->crend(); }
+
   // methods for accessing the container capacity information
   bool empty() const noexcept { return size_ == 0; }
 
@@ -69,49 +99,105 @@ class set {
 
   size_type max_size() const noexcept {
     return std::numeric_limits<size_type>::max() /
-           sizeof(BinaryTree<T, Compare>) / 2;
+           sizeof(tree_type) / 2;
   }
 
   // methods for modifying a container
   void clear() {
-    delete root_;
-    root_ = new BinaryTree<T, Compare>(root);
+    root_->clear();
     size_ = 0;
   }
 
+  // Replaces the contents with [first, last). Input already in order is
+  // built into a balanced tree in linear time.
+  template <class InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    size_ = root_->assign_sorted(first, last);
+  }
+
   std::pair<iterator, bool> insert(const_reference value) {
     std::pair<iterator, bool> ret = root_->insert(value);
     if (ret.second == true) size_++;
     return ret;
   }
 
+  std::pair<iterator, bool> insert(value_type &&value) {
+    std::pair<iterator, bool> ret = root_->insert(std::move(value));
+    if (ret.second) ++size_;
+    return ret;
+  }
+
   size_type erase(const T &value) {
     size_type count = root_->del(value);
     size_ -= count;
     return count;
   }
 
+  // Key-type overloads below need a transparent Compare such as
+  // std::less<>.
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type erase(const K &key) {
+    size_type count = root_->del(key);
+    size_ -= count;
+    return count;
+  }
+
   void erase(iterator pos) {
     size_type count = root_->erase(pos);
     size_ -= count;
   }
 
+  // Removes [first, last) in O(log n + k) by cutting the range out of the
+  // tree instead of erasing element by element.
+  iterator erase(iterator first, iterator last) {
+    size_ -= root_->erase_range(first, last);
+    return last;
+  }
+
+  // Moves the elements not less than key into the returned set by
+  // splitting the tree, O(log n) relinking with nothing copied.
+  set split(const_reference key) {
+    set upper(get_allocator());
+    upper.size_ = root_->split(root_->lower_bound(key), *upper.root_, size_);
+    size_ -= upper.size_;
+    return upper;
+  }
+
+  // Moves all of other in by joining the trees in O(log n). The elements
+  // of other must all be less, or all be greater, than the ones here;
+  // otherwise std::invalid_argument is thrown and nothing moves.
+  void join(set &other) {
+    root_->join(*other.root_, true);
+    size_ += std::exchange(other.size_, 0);
+  }
+
+  // Moves the elements in [lo, hi) into the returned set: two splits and a
+  // join, O(log n) relinking.
+  set extract_range(const_reference lo, const_reference hi) {
+    set middle = split(lo);
+    set tail = middle.split(hi);
+    join(tail);
+    return middle;
+  }
+
   size_type count(const value_type value) { return root_->count_unique(value); }
 
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  size_type count(const K &key) { return root_->count_unique(key); }
+
   void merge(set &other) {
-    s21::vector<key_type> values_to_erase;
-    if (other.empty()) return;
-    for (iterator it = other.begin(); it != other.end(); it++) {
-      iterator i = find(*it);
-      if (i == end()) {
-        insert(*it);
-        values_to_erase.push_back(*it);
-      }
-    }
-    while (!values_to_erase.empty()) {
-      other.erase(values_to_erase.back());
-      values_to_erase.pop_back();
-    }
+    size_type moved = root_->Merge(*other.root_, true, size_, other.size_);
+    size_ += moved;
+    other.size_ -= moved;
+  }
+
+  // Replaces the contents with op applied to a and b, either of which may
+  // be this set; see BinaryTree::AssignSetOperation. The free functions
+  // in s21_set_algebra.h can also split large inputs across threads.
+  void assign_set_operation(SetOperation op, const set &a, const set &b) {
+    set result(get_allocator());
+    result.size_ = result.root_->AssignSetOperation(op, *a.root_, *b.root_);
+    swap(result);
   }
 
   void swap(set &other) {
@@ -119,21 +205,108 @@ class set {
     std::swap(other.size_, this->size_);
   }
 
+  // Inserts value as close before hint as the order allows, amortized O(1)
+  // when hint is right (such as the previous insertion, or end() for
+  // ascending input); otherwise it costs an ordinary insert.
+  iterator insert(iterator hint, const_reference value) {
+    std::pair<iterator, bool> ret = root_->insert_hint(hint, value, true);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  iterator insert(iterator hint, value_type &&value) {
+    std::pair<iterator, bool> ret =
+        root_->insert_hint(hint, std::move(value), true);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Node handles: extract() takes an element out together with its node
+  // and insert() links that node into another set, so elements move
+  // between sets, and can be changed on the way, with no allocation or
+  // copy.
+  node_type extract(iterator pos) {
+    node_type node = root_->extract(pos);
+    if (node) --size_;
+    return node;
+  }
+
+  node_type extract(const_reference key) {
+    return extract(find(key));
+  }
+
+  insert_return_type insert(node_type &&node) {
+    std::pair<iterator, bool> ret = root_->insert_node(node, true);
+    if (ret.second) ++size_;
+    return {ret.first, ret.second, std::move(node)};
+  }
+
+  iterator insert(iterator hint, node_type &&node) {
+    std::pair<iterator, bool> ret = root_->insert_node(node, true, hint);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Constructs the element in its node from args.
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    std::pair<iterator, bool> ret =
+        root_->emplace_hint(hint, true, std::forward<Args>(args)...);
+    if (ret.second) ++size_;
+    return ret.first;
+  }
+
+  // Inserts each argument as an element of its own, constructed in place
+  // from it.
   template <typename... Args>
   s21::vector<std::pair<iterator, bool>> emplace(Args &&...args) {
-    return root_->Emplace(std::forward<Args>(args)...);
+    s21::vector<std::pair<iterator, bool>> ret =
+        root_->Emplace(true, std::forward<Args>(args)...);
+    for (const auto &item : ret) size_ += item.second;
+    return ret;
   }
 
   // methods for viewing the container
   iterator find(const_reference value) { return root_->find(value); }
 
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator find(const K &key) { return root_->find(key); }
+
   bool contains(const T value) { return root_->contains(value); }
 
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  bool contains(const K &key) { return root_->contains(key); }
+
+  iterator lower_bound(const_reference key) { return root_->lower_bound(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator lower_bound(const K &key) { return root_->lower_bound(key); }
+
+  iterator upper_bound(const_reference key) { return root_->upper_bound(key); }
+
+  template <class K, class C = Compare, class = RequireTransparent<C>>
+  iterator upper_bound(const K &key) { return root_->upper_bound(key); }
+
+  // Order statistics in O(log n), available with OrderStatistics set.
+  size_type rank(const_reference key) const { return root_->rank(key); }
+
+  iterator select(size_type index) { return root_->select(index); }
+
+  size_type count_range(const_reference lo, const_reference hi) const {
+    return root_->count_range(lo, hi);
+  }
+
  private:
-  static constexpr bool root = true;
+  friend class ParallelSetOperation<tree_type>;
+
   size_type size_;
-  BinaryTree<T, Compare> *root_;
+  tree_type *root_;
 };
+
+namespace pmr {
+template <class T, class Compare = std::less<T>>
+using set = s21::set<T, Compare, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_SET_H
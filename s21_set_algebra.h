@@ -0,0 +1,207 @@
+#ifndef SRC_S21_SET_ALGEBRA_H
+#define SRC_S21_SET_ALGEBRA_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+#include "s21_multiset.h"
+#include "s21_set.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Set algebra spread over worker threads. Inputs are cut at pivots taken
+// from the top levels of the larger tree; each key range is merged and
+// built into a balanced subtree by a worker, and the pieces are joined in
+// order. The workers share the result's allocator, so only allocators
+// that are always equal go parallel; others run the serial merge.
+template <class Tree>
+class ParallelSetOperation {
+  using size_type = typename Tree::size_type;
+  using NodeBase = typename Tree::NodeBase;
+
+ public:
+  // With threads left at 0, inputs of at least this many elements in
+  // total run on every hardware thread, smaller ones serially.
+  static constexpr size_type kMinSize = size_type{1} << 16;
+
+  template <class Set>
+  static Set Run(SetOperation op, const Set &a, const Set &b,
+                 unsigned threads) {
+    Set result(a.get_allocator());
+    bool parallel = Tree::node_traits::is_always_equal::value &&
+                    (threads > 1 ||
+                     (threads == 0 && a.size_ + b.size_ >= kMinSize));
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (parallel && threads > 1) {
+      const Tree &larger = a.size_ < b.size_ ? *b.root_ : *a.root_;
+      result.size_ =
+          Assign(*result.root_, op, *a.root_, *b.root_, larger, threads);
+    } else {
+      result.assign_set_operation(op, a, b);
+    }
+    return result;
+  }
+
+ private:
+  // One key range of the result, built into its own tree. A worker that
+  // throws leaves its exception here.
+  struct Part {
+    NodeBase header{{}, nullptr, nullptr, nullptr, Tree::kHeaderHeight};
+    size_type count = 0;
+    std::exception_ptr error;
+  };
+
+  // The nodes in the top depth levels of a subtree, in order.
+  static void CollectPivots(const NodeBase *node, int depth,
+                            s21::vector<const NodeBase *> &pivots) {
+    if (!node || depth == 0) return;
+    CollectPivots(node->left_, depth - 1, pivots);
+    pivots.push_back(node);
+    CollectPivots(node->right_, depth - 1, pivots);
+  }
+
+  // Cutting both inputs at the lower bounds of the same pivots keeps every
+  // run of equal elements inside one range, so repeated elements come out
+  // the same as in a sequential pass. About two ranges per thread even
+  // out the subtrees AVL balance leaves unequal.
+  static size_type Assign(Tree &out, SetOperation op, const Tree &a,
+                          const Tree &b, const Tree &larger,
+                          unsigned threads) {
+    int depth = 1;
+    while ((size_type{1} << depth) < 2 * size_type{threads}) ++depth;
+    s21::vector<const NodeBase *> pivots;
+    CollectPivots(larger.Root(), depth, pivots);
+    size_type parts = pivots.size() + 1;
+    std::unique_ptr<Part[]> results(new Part[parts]);
+    for (size_type k = 0; k < parts; ++k) {
+      Tree::ResetHeader(&results[k].header);
+    }
+    std::atomic<size_type> next{0};
+    auto work = [&] {
+      for (size_type k = next++; k < parts; k = next++) {
+        Part &part = results[k];
+        try {
+          const NodeBase *a_first = a.header_.next_;
+          const NodeBase *b_first = b.header_.next_;
+          const NodeBase *a_last = &a.header_;
+          const NodeBase *b_last = &b.header_;
+          if (k > 0) {
+            a_first = out.LowerBoundNode(a, Tree::Value(pivots[k - 1]));
+            b_first = out.LowerBoundNode(b, Tree::Value(pivots[k - 1]));
+          }
+          if (k + 1 < parts) {
+            a_last = out.LowerBoundNode(a, Tree::Value(pivots[k]));
+            b_last = out.LowerBoundNode(b, Tree::Value(pivots[k]));
+          }
+          NodeBase *list = out.SetOperationList(op, a_first, a_last, b_first,
+                                                b_last, part.count);
+          Tree::BuildTree(&part.header, list, part.count);
+        } catch (...) {
+          part.error = std::current_exception();
+        }
+      }
+    };
+    size_type helpers = std::min(size_type{threads}, parts) - 1;
+    s21::vector<std::thread> workers;
+    workers.reserve(helpers);
+    try {
+      for (size_type i = 0; i < helpers; ++i) {
+        workers.push_back(std::thread(work));
+      }
+    } catch (const std::system_error &) {
+      // Out of threads: the ranges left over run on this one.
+    }
+    work();
+    for (std::thread &worker : workers) worker.join();
+    for (size_type k = 0; k < parts; ++k) {
+      if (!results[k].error) continue;
+      for (size_type j = 0; j < parts; ++j) {
+        out.DeleteNode(results[j].header.left_);
+      }
+      std::rethrow_exception(results[k].error);
+    }
+    size_type count = 0;
+    for (size_type k = 0; k < parts; ++k) {
+      count += results[k].count;
+      Tree::Append(&out.header_, &results[k].header);
+    }
+    return count;
+  }
+};
+
+// Set algebra on sorted containers, producing a new container that uses
+// the allocator of a. Inputs of similar size are merged in one linear
+// pass; where one side is much smaller the other is crossed by galloping
+// search, O(m log(n / m)) instead of the O(m log n) of a find per element.
+// Large inputs are cut into key ranges that are merged on separate threads
+// and joined back together. threads = 0 decides by size and the hardware;
+// 1 forces a serial pass. Multiset results repeat elements the way
+// std::set_union and friends do.
+template <class Set>
+Set SetAlgebra(SetOperation op, const Set &a, const Set &b,
+               unsigned threads) {
+  return ParallelSetOperation<typename Set::tree_type>::Run(op, a, b,
+                                                            threads);
+}
+
+template <class T, class C, class A, bool S>
+set<T, C, A, S> set_union(const set<T, C, A, S> &a, const set<T, C, A, S> &b,
+                          unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kUnion, a, b, threads);
+}
+
+template <class T, class C, class A, bool S>
+set<T, C, A, S> set_intersection(const set<T, C, A, S> &a,
+                                 const set<T, C, A, S> &b,
+                                 unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kIntersection, a, b, threads);
+}
+
+template <class T, class C, class A, bool S>
+set<T, C, A, S> set_difference(const set<T, C, A, S> &a,
+                               const set<T, C, A, S> &b,
+                               unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kDifference, a, b, threads);
+}
+
+template <class T, class C, class A, bool S>
+set<T, C, A, S> symmetric_difference(const set<T, C, A, S> &a,
+                                     const set<T, C, A, S> &b,
+                                     unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kSymmetricDifference, a, b, threads);
+}
+
+template <class T, class C, class A, bool S>
+multiset<T, C, A, S> set_union(const multiset<T, C, A, S> &a,
+                               const multiset<T, C, A, S> &b,
+                               unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kUnion, a, b, threads);
+}
+
+template <class T, class C, class A, bool S>
+multiset<T, C, A, S> set_intersection(const multiset<T, C, A, S> &a,
+                                      const multiset<T, C, A, S> &b,
+                                      unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kIntersection, a, b, threads);
+}
+
+template <class T, class C, class A, bool S>
+multiset<T, C, A, S> set_difference(const multiset<T, C, A, S> &a,
+                                    const multiset<T, C, A, S> &b,
+                                    unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kDifference, a, b, threads);
+}
+
+template <class T, class C, class A, bool S>
+multiset<T, C, A, S> symmetric_difference(const multiset<T, C, A, S> &a,
+                                          const multiset<T, C, A, S> &b,
+                                          unsigned threads = 0) {
+  return SetAlgebra(SetOperation::kSymmetricDifference, a, b, threads);
+}
+}  // namespace s21
+
+#endif  // SRC_S21_SET_ALGEBRA_H
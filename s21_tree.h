@@ -6,20 +6,94 @@
 #include <cstddef>
 #include <ios>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <new>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 
 #include "s21_vector.h"
 
 namespace s21 {
-template <class T, class Comparator = std::less<T>>
+// Constrains range constructors so that (count, value)-like integral
+// argument pairs never bind to them.
+template <class InputIt>
+using RequireInputIterator = std::enable_if_t<std::is_convertible<
+    typename std::iterator_traits<InputIt>::iterator_category,
+    std::input_iterator_tag>::value>;
+
+// Comparators declaring is_transparent compare keys of other types against
+// elements directly, so lookups need not build a value_type first.
+template <class Compare, class = void>
+struct IsTransparent : std::false_type {};
+
+template <class Compare>
+struct IsTransparent<Compare, std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+// Enables heterogeneous lookup overloads for transparent comparators only.
+template <class Compare>
+using RequireTransparent = typename Compare::is_transparent;
+
+// The type flat storage keeps for Value. A map's pair<const Key, T> is
+// stored as pair<Key, T>, so relocating an element moves its key instead
+// of copying it; the slots are still handed out as Value, whose layout is
+// the same.
+template <class Value>
+struct SlotType {
+  using type = Value;
+};
+
+template <class Key, class T>
+struct SlotType<std::pair<const Key, T>> {
+  using type = std::pair<Key, T>;
+};
+
+// Subtree size kept in every node of an order-statistic tree; plain trees
+// get the empty base and pay nothing for it.
+template <bool OrderStatistics>
+struct TreeNodeSize {};
+
+template <>
+struct TreeNodeSize<true> {
+  std::size_t size_ = 1;
+};
+
+// The operations BinaryTree::AssignSetOperation computes. With repeated
+// elements they follow std::set_union and friends: an element kept by
+// union appears max(m, n) times, by intersection min(m, n), by difference
+// max(m - n, 0) and by symmetric difference |m - n|.
+enum class SetOperation {
+  kUnion,
+  kIntersection,
+  kDifference,
+  kSymmetricDifference
+};
+
+// Runs a set operation on worker threads; defined in s21_set_algebra.h so
+// that only its users pull in the threading headers.
+template <class Tree>
+class ParallelSetOperation;
+
+template <class T, class Comparator = std::less<T>,
+          class Allocator = std::allocator<T>, bool OrderStatistics = false>
 class BinaryTree {
+  struct NodeBase;
+  struct TreeNode;
+
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<TreeNode>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
  public:
   struct tree_iterator;
   struct tree_const_iterator;
+  class node_handle;
+  struct insert_return_type;
 
   using value_type = T;
   using size_type = std::size_t;
@@ -27,252 +101,830 @@ class BinaryTree {
   using const_reference = const T &;
   using iterator = tree_iterator;
   using const_iterator = tree_const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using allocator_type = Allocator;
 
-  BinaryTree() noexcept { InitEmptyNode(); }
-
-  BinaryTree(bool parent_is_root) noexcept : parent_(nullptr) {
-    InitEmptyNode();
-    InitParentRoot(parent_is_root);
-  };
+  BinaryTree() : BinaryTree(Allocator()) {}
 
-  BinaryTree(BinaryTree *node, bool root = false) noexcept : parent_(node) {
-    InitEmptyNode();
-    if (root) {
-      InitRoot(node);
-    }
-  };
+  explicit BinaryTree(const Allocator &alloc) noexcept : allocator_(alloc) {
+    InitHeader();
+  }
 
-  BinaryTree(const_reference value) noexcept : parent_(nullptr) {
-    bool parent_is_root = true;
-    InitNode(value);
-    InitParentRoot(parent_is_root);
-  };
+  BinaryTree(const_reference value) : BinaryTree() { InsertValue(value); }
 
-  BinaryTree(const BinaryTree &other) {
-    if (!other)
-      throw std::invalid_argument("s21::tree::CopyConstructor(): No root");
-    CopyTree(other);
+  BinaryTree(const BinaryTree &other)
+      : BinaryTree(node_traits::select_on_container_copy_construction(
+            other.allocator_)) {
+    NodeBase *reuse = nullptr;
+    CopyTree(other.Root(), reuse);
   }
 
+  // Clones other's shape directly, recycling this tree's nodes first.
   BinaryTree &operator=(const BinaryTree &other) {
     if (this == &other) {
       return *this;
     }
-    this->DeleteNode();
-    CopyTree(other);
+    NodeBase *reuse = DetachNodes(Root());
+    InitHeader();
+    try {
+      CopyTree(other.Root(), reuse);
+    } catch (...) {
+      FreeNodeList(reuse);
+      throw;
+    }
+    FreeNodeList(reuse);
     return *this;
   }
 
-  ~BinaryTree() noexcept {
-    if (IsParentRoot()) delete parent_;
-    DeleteNode();
+  ~BinaryTree() noexcept { Clear(); }
+
+  void clear() noexcept { Clear(); }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(allocator_);
   }
 
-  void Merge(const BinaryTree *other) { this->CopyAllTree(other); }
+  // Moves other's elements into this tree by relinking their nodes, with
+  // no allocation and no value copies; with unique set, elements whose key
+  // is already present stay in other. Sizes pick between relinking node by
+  // node and a linear merge of both sorted sequences. Returns the number of
+  // elements moved.
+  size_type Merge(BinaryTree &other, bool unique, size_type size,
+                  size_type other_size) {
+    if (this == &other || !other.Root()) return 0;
+    if (!node_traits::is_always_equal::value &&
+        !(allocator_ == other.allocator_)) {
+      return MergeByCopying(other, unique);
+    }
+    size_type total = size + other_size;
+    size_type depth = 1;
+    while (total >> depth) ++depth;
+    if (other_size * depth > 2 * total) return MergeByRebuilding(other, unique);
+    return MergeByRelinking(other, unique);
+  }
 
+  // Moves [pos, end()) into the empty tree other by cutting the tree in
+  // two, O(log n) relinking with no allocation; size is this tree's element
+  // count. Returns the number of elements moved, which comes from the
+  // subtree sizes with OrderStatistics and otherwise from walking outwards
+  // from pos in both directions until the nearer end: O(min(k, n - k)).
+  size_type split(iterator pos, BinaryTree &other, size_type size) {
+    NodeBase *node = pos.data();
+    if (!node || node == &header_ || this == &other) return 0;
+    if (!node_traits::is_always_equal::value &&
+        !(allocator_ == other.allocator_)) {
+      size_type moved = 0;
+      while (node != &header_) {
+        NodeBase *next = node->next_;
+        other.InsertNonUniqueValue(Value(node));
+        DeleteByAddress(node);
+        node = next;
+        ++moved;
+      }
+      return moved;
+    }
+    size_type moved = CountFrom(node, size);
+    SplitAt(&header_, node, &other.header_);
+    return moved;
+  }
+
+  // Moves all of other into this tree in O(log n) by joining the two
+  // shapes. Every element of other must order entirely after, or entirely
+  // before, every element here (strictly when unique is set); overlapping
+  // ranges throw std::invalid_argument and leave both trees untouched.
+  void join(BinaryTree &other, bool unique) {
+    if (this == &other || !other.Root()) return;
+    bool after = true;
+    bool before = true;
+    if (Root()) {
+      after = unique ? comparator_(Value(header_.prev_),
+                                   Value(other.header_.next_))
+                     : !comparator_(Value(other.header_.next_),
+                                    Value(header_.prev_));
+      before = unique ? comparator_(Value(other.header_.prev_),
+                                    Value(header_.next_))
+                      : !comparator_(Value(header_.next_),
+                                     Value(other.header_.prev_));
+    }
+    if (!after && !before) {
+      throw std::invalid_argument("s21::tree::join: ranges overlap");
+    }
+    if (!node_traits::is_always_equal::value &&
+        !(allocator_ == other.allocator_)) {
+      MergeByCopying(other, unique);
+    } else if (after) {
+      Append(&header_, &other.header_);
+    } else {
+      NodeBase high{{}, nullptr, nullptr, nullptr, kHeaderHeight};
+      ResetHeader(&high);
+      MoveHeader(&high, &header_);
+      MoveHeader(&header_, &other.header_);
+      Append(&header_, &high);
+    }
+  }
+
+  // Removes [first, last) by cutting it out with two splits and joining
+  // the rest back: O(log n + k) for k removed elements, which is the count
+  // returned. The cut-out nodes are freed along the in-order thread, one
+  // pass that counts them as it goes.
+  size_type erase_range(iterator first, iterator last) {
+    NodeBase *node = first.data();
+    if (!node || node == &header_ || first == last) return 0;
+    NodeBase middle{{}, nullptr, nullptr, nullptr, kHeaderHeight};
+    NodeBase tail{{}, nullptr, nullptr, nullptr, kHeaderHeight};
+    ResetHeader(&middle);
+    ResetHeader(&tail);
+    SplitAt(&header_, node, &middle);
+    if (last.data() != &header_) SplitAt(&middle, last.data(), &tail);
+    size_type count = 0;
+    for (NodeBase *n = middle.next_; n != &middle; ++count) {
+      NodeBase *next = n->next_;
+      DestroyNode(n);
+      n = next;
+    }
+    Append(&header_, &tail);
+    return count;
+  }
+
+  // Fills this empty tree with op applied to a and b and returns the
+  // number of elements. Both inputs are walked once in order, except that
+  // a cursor skipping over elements the result drops gallops: after a few
+  // single steps it switches to a finger search up and down the tree, so
+  // intersecting 1k elements with 1M costs O(m log(n / m)), not O(n). The
+  // multithreaded variant is ParallelSetOperation in s21_set_algebra.h.
+  size_type AssignSetOperation(SetOperation op, const BinaryTree &a,
+                               const BinaryTree &b) {
+    Clear();
+    size_type count = 0;
+    NodeBase *list = SetOperationList(op, a.header_.next_, &a.header_,
+                                      b.header_.next_, &b.header_, count);
+    BuildTree(&header_, list, count);
+    return count;
+  }
+
+  // Lookups take a value_type, or with a transparent comparator any key
+  // type it can compare against elements.
   iterator find(const value_type value) { return Find(value); }
 
-  size_type count(const value_type value) { return CountAll(value); }
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  iterator find(const K &key) { return Find(key); }
+
+  // Counts by comparator in O(log n + k) for k matches; with
+  // OrderStatistics the count comes from ranks in O(log n).
+  size_type count(const value_type &value) { return CountEqual(value); }
+
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  size_type count(const K &key) { return CountEqual(key); }
 
   size_type count_unique(const value_type value) {
     return FindNode(value) ? 1 : 0;
   }
 
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  size_type count_unique(const K &key) { return FindNode(key) ? 1 : 0; }
+
   iterator lower_bound(const value_type &key) { return FindLowerBound(key); }
 
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  iterator lower_bound(const K &key) { return FindLowerBound(key); }
+
   iterator upper_bound(const value_type &key) { return FindUpperBound(key); }
 
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  iterator upper_bound(const K &key) { return FindUpperBound(key); }
+
+  std::pair<iterator, iterator> equal_range(const value_type &key) {
+    std::pair<NodeBase *, NodeBase *> range = EqualRange(key);
+    return std::make_pair(iterator(range.first), iterator(range.second));
+  }
+
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    std::pair<NodeBase *, NodeBase *> range = EqualRange(key);
+    return std::make_pair(iterator(range.first), iterator(range.second));
+  }
+
   size_type del(const_reference value) {
-    BinaryTree *node = FindNode(value);
+    NodeBase *node = FindNode(value);
     return DeleteByAddress(node);
   }
 
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  size_type del(const K &key) { return DeleteByAddress(FindNode(key)); }
+
+  // Removes every element equal to value, found by a single descent.
+  size_type del_non_unique(const_reference value) { return DeleteEqual(value); }
+
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  size_type del_non_unique(const K &key) { return DeleteEqual(key); }
+
   size_type erase(iterator pos) {
     if (pos == end()) return 0;
-    BinaryTree *node = FindNode(*pos);
-    return DeleteByAddress(node);
+    return DeleteByAddress(pos.data());
   }
 
   size_type max_size() {
-    return std::numeric_limits<size_type>::max() / sizeof(BinaryTree<T>);
+    return std::numeric_limits<size_type>::max() / sizeof(TreeNode);
   }
 
   bool contains(const value_type value) {
     return this->FindNode(value) ? true : false;
   }
 
+  template <class K, class C = Comparator, class = RequireTransparent<C>>
+  bool contains(const K &key) { return FindNode(key) != nullptr; }
+
   std::pair<iterator, bool> insert(const value_type &pair) {
-    std::pair<BinaryTree *, bool> p = InsertValue(pair);
+    std::pair<NodeBase *, bool> p = InsertValue(pair);
     iterator it = tree_iterator(p.first);
     return std::make_pair(it, p.second);
   }
 
+  std::pair<iterator, bool> insert(value_type &&value) {
+    std::pair<NodeBase *, bool> p = InsertValue(std::move(value));
+    return std::make_pair(iterator(p.first), p.second);
+  }
+
   std::pair<iterator, bool> insert_non_unique(const value_type &pair) {
-    std::pair<BinaryTree *, bool> p = InsertNonUniqueValue(pair);
+    std::pair<NodeBase *, bool> p = InsertNonUniqueValue(pair);
     iterator it = tree_iterator(p.first);
     return std::make_pair(it, p.second);
   }
 
+  std::pair<iterator, bool> insert_non_unique(value_type &&value) {
+    std::pair<NodeBase *, bool> p = InsertNonUniqueValue(std::move(value));
+    return std::make_pair(iterator(p.first), p.second);
+  }
+
+  // Inserts value next to hint when it belongs there: the link is found
+  // from hint and its neighbour alone, and an AVL insertion rebalances a
+  // constant number of levels on average, so sorted input costs amortized
+  // O(1) per element when each hint is the previous insertion or end().
+  // A wrong hint falls back to a descent from the root. Among equal
+  // elements the new one goes as close before hint as it can.
+  std::pair<iterator, bool> insert_hint(iterator hint, const value_type &value,
+                                        bool unique) {
+    std::pair<NodeBase *, bool> p = InsertHinted(hint.data(), value, unique);
+    return std::make_pair(iterator(p.first), p.second);
+  }
+
+  std::pair<iterator, bool> insert_hint(iterator hint, value_type &&value,
+                                        bool unique) {
+    std::pair<NodeBase *, bool> p =
+        InsertHinted(hint.data(), std::move(value), unique);
+    return std::make_pair(iterator(p.first), p.second);
+  }
+
+  // Constructs the element in a new node from args and links it in, using
+  // hint as insert_hint does (a default iterator means no hint). The key
+  // is only known once the element exists, so with unique set a duplicate
+  // costs the node, which is destroyed again.
+  template <class... Args>
+  std::pair<iterator, bool> emplace_hint(iterator hint, bool unique,
+                                         Args &&...args) {
+    NodeBase *node = ConstructNode(nullptr, std::forward<Args>(args)...);
+    NodeBase *parent = nullptr;
+    NodeBase **link = FindHintLink(hint.data(), Value(node), unique, parent);
+    if (!link) {
+      DestroyNode(node);
+      return std::make_pair(iterator(parent), false);
+    }
+    LinkNode(node, parent, link);
+    return std::make_pair(iterator(node), true);
+  }
+
+  // Read-modify-write in one descent: finds the element equal to key or
+  // the link where it belongs, then calls fn(element, existed). When key
+  // is absent the element is constructed from args first but only linked
+  // in if fn returns true; an existing element for which fn returns false
+  // is erased. fn must not modify the tree. Returns the element, or end()
+  // when there is none afterwards, and the change in element count.
+  template <class K, class F, class... Args>
+  std::pair<iterator, int> compute(const K &key, F &&fn, Args &&...args) {
+    NodeBase *parent = nullptr;
+    NodeBase **link = FindLink(key, true, parent);
+    if (!link) {
+      if (fn(Value(parent), true)) return std::make_pair(iterator(parent), 0);
+      DeleteByAddress(parent);
+      return std::make_pair(end(), -1);
+    }
+    NodeBase *node = ConstructNode(parent, std::forward<Args>(args)...);
+    bool keep = false;
+    try {
+      keep = fn(Value(node), false);
+    } catch (...) {
+      DestroyNode(node);
+      throw;
+    }
+    if (!keep) {
+      DestroyNode(node);
+      return std::make_pair(end(), 0);
+    }
+    LinkNode(node, parent, link);
+    return std::make_pair(iterator(node), 1);
+  }
+
+  // Unlinks the element at pos and hands its node over to the returned
+  // handle: nothing is freed, copied or moved.
+  node_handle extract(iterator pos) {
+    NodeBase *node = pos.data();
+    if (!node || node == &header_) return node_handle();
+    UnlinkNode(node);
+    return node_handle(node, allocator_);
+  }
+
+  // Links the node held by handle in, found as insert_hint finds a link,
+  // and empties the handle. With unique set and an equal element present
+  // the handle keeps its node and that element is returned. A handle from
+  // a tree whose allocator compares unequal has its element moved into a
+  // node of this tree's own instead.
+  std::pair<iterator, bool> insert_node(node_handle &handle, bool unique,
+                                        iterator hint = iterator()) {
+    if (!handle) return std::make_pair(end(), false);
+    NodeBase *parent = nullptr;
+    NodeBase **link =
+        FindHintLink(hint.data(), Value(handle.node_), unique, parent);
+    if (!link) return std::make_pair(iterator(parent), false);
+    if (!node_traits::is_always_equal::value &&
+        !(*handle.allocator_ == allocator_)) {
+      NodeBase *node = ConstructNode(parent, std::move(handle.value()));
+      handle.Reset();
+      LinkNode(node, parent, link);
+      return std::make_pair(iterator(node), true);
+    }
+    NodeBase *node = handle.Release();
+    LinkNode(node, parent, link);
+    return std::make_pair(iterator(node), true);
+  }
+
+  // Looks key up and, only when no equal element exists, constructs one
+  // from args where the search ended: one descent, and nothing is built
+  // for a key already present.
+  template <class K, class... Args>
+  std::pair<iterator, bool> try_emplace(const K &key, Args &&...args) {
+    NodeBase *parent = nullptr;
+    NodeBase **link = FindLink(key, true, parent);
+    if (!link) return std::make_pair(iterator(parent), false);
+    NodeBase *node = ConstructNode(parent, std::forward<Args>(args)...);
+    LinkNode(node, parent, link);
+    return std::make_pair(iterator(node), true);
+  }
+
+  // Order statistics in O(log n); they need a tree built with
+  // OrderStatistics. rank() is the number of elements less than key.
+  size_type rank(const value_type &key) const noexcept {
+    static_assert(OrderStatistics, "s21::tree: order statistics disabled");
+    size_type rank = 0;
+    for (NodeBase *node = Root(); node;) {
+      if (comparator_(Value(node), key)) {
+        rank += Size(node->left_) + 1;
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
+    }
+    return rank;
+  }
+
+  // The element at position index in order, end() when out of range.
+  iterator select(size_type index) noexcept {
+    return iterator(SelectNode(&header_, index));
+  }
+
+  // Number of elements in [lo, hi).
+  size_type count_range(const value_type &lo,
+                        const value_type &hi) const noexcept {
+    size_type lo_rank = rank(lo);
+    size_type hi_rank = rank(hi);
+    return hi_rank > lo_rank ? hi_rank - lo_rank : 0;
+  }
+
+  // Height of the root, -1 for an empty tree.
+  int height() const noexcept { return Height(Root()); }
+
   std::string inorder_traversal(bool endl) {
-    if (!data_) return "";
-    std::string ans = "";
-    ans += left_->inorder_traversal(endl);
-    ans += std::to_string(data_->value) + ":" + std::to_string(height_);
-    ans += ",";
-    if (endl) ans += "\n";
-    ans += right_->inorder_traversal(endl);
-    return ans;
+    return InorderTraversal(Root(), endl);
   }
 
+  // The header's in-order links are the leftmost and rightmost nodes (or
+  // the header itself when empty), so all the ends are O(1).
   iterator begin() {
-    tree_iterator it(MinimumNode(this));
+    tree_iterator it(header_.next_);
     return it;
   }
 
   iterator end() {
-    tree_iterator it(this);
-    return it.end();
+    tree_iterator it(&header_);
+    return it;
   }
 
   const_iterator cbegin() {
-    const_iterator it(MinimumNode(this));
+    const_iterator it(header_.next_);
     return it;
   }
 
   const_iterator cend() {
-    const_iterator it(this);
-    return it.end();
+    const_iterator it(&header_);
+    return it;
   }
 
-  void CopyAllTree(const BinaryTree *other) {
-    if (!other || !other->data_) return;
-    CopyAllTree(other->left_);
-    InsertNonUniqueValue(other->data_->value);
-    CopyAllTree(other->right_);
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  const_reverse_iterator crbegin() { return const_reverse_iterator(cend()); }
+
+  const_reverse_iterator crend() { return const_reverse_iterator(cbegin()); }
+
+  // Replaces the contents with [first, last) and returns the new size.
+  // Sorted input is linked into a perfectly balanced tree in O(n) without
+  // a single rotation; anything else is merge sorted once beforehand.
+  template <class InputIt>
+  size_type assign_sorted(InputIt first, InputIt last) {
+    return AssignRange(first, last, true);
   }
 
-  BinaryTree *FindNode(const value_type value) {
-    if (!data_) return nullptr;
-    if (comparator_(value, data_->value)) {
-      return left_->FindNode(value);
-    } else if (comparator_(data_->value, value)) {
-      return right_->FindNode(value);
-    } else {
-      return this;
-    }
+  template <class InputIt>
+  size_type assign_sorted_non_unique(InputIt first, InputIt last) {
+    return AssignRange(first, last, false);
   }
 
+  // Inserts one element per argument, each constructed in its own node
+  // from that argument alone.
   template <typename... Args>
-  s21::vector<std::pair<iterator, bool>> Emplace(Args &&...args) {
+  s21::vector<std::pair<iterator, bool>> Emplace(bool unique, Args &&...args) {
     s21::vector<std::pair<iterator, bool>> ret;
-    for (auto &&item : {std::forward<Args>(args)...})
-      ret.push_back(insert(item));
+    ret.reserve(sizeof...(args));
+    (ret.push_back(emplace_hint(iterator(), unique, std::forward<Args>(args))),
+     ...);
     return ret;
   }
 
  private:
-  void InitNode(const_reference value) {
-    left_ = new BinaryTree(this);
-    right_ = new BinaryTree(this);
-    height_ = 0;
-    root_child_ = nullptr;
-    data_ = new node_(value);
+  friend class ParallelSetOperation<BinaryTree>;
+
+  // The header is the end() sentinel: its left_ points to the root and its
+  // height_ is kHeaderHeight. Empty subtrees are plain null pointers, so a
+  // tree of N elements owns exactly N TreeNode allocations, each holding its
+  // links and its value side by side. Every node is also threaded into a
+  // circular in-order list through prev_ and next_, closed by the header,
+  // so iterators step in O(1) without touching the tree shape.
+  static constexpr int kHeaderHeight = -2;
+
+  void InitHeader() noexcept { ResetHeader(&header_); }
+
+  static void ResetHeader(NodeBase *header) noexcept {
+    header->parent_ = nullptr;
+    header->left_ = nullptr;
+    header->right_ = nullptr;
+    header->height_ = kHeaderHeight;
+    header->prev_ = header;
+    header->next_ = header;
   }
 
-  void InitEmptyNode() {
-    root_child_ = nullptr;
-    left_ = nullptr;
-    right_ = nullptr;
-    height_ = -1;
-    data_ = nullptr;
-    status_ = BalanceStatus::kNone;
+  // Hands the whole tree under from over to the empty header to.
+  static void MoveHeader(NodeBase *to, NodeBase *from) noexcept {
+    if (!from->left_) return;
+    to->left_ = from->left_;
+    to->left_->parent_ = to;
+    to->next_ = from->next_;
+    to->next_->prev_ = to;
+    to->prev_ = from->prev_;
+    to->prev_->next_ = to;
+    ResetHeader(from);
   }
 
-  void InitParentRoot(bool root) {
-    parent_ = new BinaryTree(this, root);
-    parent_->root_child_ = this;
+  NodeBase *Root() const noexcept { return header_.left_; }
+
+  NodeBase *CreateNode(const_reference value, NodeBase *parent) {
+    return ConstructNode(parent, value);
   }
 
-  void InitRoot(BinaryTree *node) {
-    root_child_ = node;
-    height_ = -2;
+  // Allocates a node and constructs its element in place from args.
+  template <class... Args>
+  NodeBase *ConstructNode(NodeBase *parent, Args &&...args) {
+    TreeNode *node = node_traits::allocate(allocator_, 1);
+    try {
+      node_traits::construct(allocator_, node, parent,
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(allocator_, node, 1);
+      throw;
+    }
+    return node;
   }
 
-  void DeleteNode() {
-    delete data_;
-    delete left_;
-    delete right_;
-    data_ = nullptr;
-    left_ = nullptr;
-    right_ = nullptr;
-    height_ = -1;
+  void DestroyNode(NodeBase *node) noexcept {
+    TreeNode *tree_node = static_cast<TreeNode *>(node);
+    node_traits::destroy(allocator_, tree_node);
+    node_traits::deallocate(allocator_, tree_node, 1);
   }
 
-  bool IsParentRoot() { return parent_ && parent_->height_ == -2; }
+  static reference Value(NodeBase *node) noexcept {
+    return static_cast<TreeNode *>(node)->value_;
+  }
 
-  size_type RemoveNode() {
-    DeleteNode();
-    return 0;
+  static const_reference Value(const NodeBase *node) noexcept {
+    return static_cast<const TreeNode *>(node)->value_;
   }
 
-  void CopyTree(const BinaryTree &other) {
-    if (!other.data_) return;
-    insert(other.data_->value);
-    if (other.left_) CopyTree(*other.left_);
-    if (other.right_) CopyTree(*other.right_);
+  // Allocators exposing release() (s21::pool_allocator) can hand back all
+  // of their memory at once, so trivially destructible values need no walk.
+  template <class A, class = void>
+  struct HasRelease : std::false_type {};
+
+  template <class A>
+  struct HasRelease<A, std::void_t<decltype(std::declval<A &>().release())>>
+      : std::true_type {};
+
+  void Clear() noexcept {
+    if constexpr (HasRelease<node_allocator>::value &&
+                  std::is_trivially_destructible<value_type>::value) {
+      if (Root() && allocator_.release()) {
+        InitHeader();
+        return;
+      }
+    }
+    DeleteNode(Root());
+    InitHeader();
   }
 
-  void CopyNonUniqueTree(const BinaryTree &other) {
-    if (!other.data_) return;
-    insert_non_unique(other.data_->value);
-    if (other.left_) CopyNonUniqueTree(*other.left_);
-    if (other.right_) CopyNonUniqueTree(*other.right_);
+  // Bulk loading works on a list of detached nodes chained through right_.
+  template <class InputIt>
+  size_type AssignRange(InputIt first, InputIt last, bool unique) {
+    NodeBase head{{}, nullptr, nullptr, nullptr, 0};
+    NodeBase *tail = &head;
+    size_type count = 0;
+    bool sorted = true;
+    try {
+      for (; first != last; ++first, ++count) {
+        NodeBase *node = CreateNode(*first, nullptr);
+        tail->right_ = node;
+        if (tail != &head && comparator_(Value(node), Value(tail))) {
+          sorted = false;
+        }
+        tail = node;
+      }
+    } catch (...) {
+      DeleteNode(head.right_);
+      throw;
+    }
+    NodeBase *list = head.right_;
+    try {
+      if (!sorted) list = SortList(list, count);
+      if (unique) count = RemoveListDuplicates(list, count);
+    } catch (...) {
+      DeleteNode(list);
+      throw;
+    }
+    Clear();
+    BuildTree(&header_, list, count);
+    return count;
   }
 
-  size_type CountAll(const value_type value) {
-    if (!data_)
-      return 0;
-    else {
-      return (value == data_->value ? 1 : 0) + left_->CountAll(value) +
-             right_->CountAll(value);
+  // Stable merge sort of the first n list nodes; list is advanced past them.
+  // If the comparator throws, every node this call holds is put back in
+  // front of list, so the caller can still free the whole chain.
+  NodeBase *SortList(NodeBase *&list, size_type n) {
+    if (n == 1) {
+      NodeBase *node = list;
+      list = list->right_;
+      node->right_ = nullptr;
+      return node;
     }
+    NodeBase *left = nullptr;
+    NodeBase *right = nullptr;
+    NodeBase head{{}, nullptr, nullptr, nullptr, 0};
+    NodeBase *tail = &head;
+    try {
+      left = SortList(list, n / 2);
+      right = SortList(list, n - n / 2);
+      while (left && right) {
+        if (comparator_(Value(right), Value(left))) {
+          tail->right_ = right;
+          right = right->right_;
+        } else {
+          tail->right_ = left;
+          left = left->right_;
+        }
+        tail = tail->right_;
+      }
+    } catch (...) {
+      tail->right_ = nullptr;
+      list = JoinLists(JoinLists(JoinLists(head.right_, left), right), list);
+      throw;
+    }
+    tail->right_ = left ? left : right;
+    return head.right_;
   }
 
-  size_type DeleteByAddress(BinaryTree *node) {
-    BinaryTree *to_delete = nullptr;
-    if (!node) return 0;
-    if (!node->left_->data_ && !node->right_->data_) {
-      node->RemoveNode();
-      node->InitEmptyNode();
-    } else if (node->data_) {
-      to_delete = SearchAndSwap(node);
-      to_delete->RemoveNode();
-      to_delete->InitEmptyNode();
-    }
-    UpdateHeight();
-    return 1;
+  // Appends the list second to the list first and returns the result.
+  static NodeBase *JoinLists(NodeBase *first, NodeBase *second) noexcept {
+    if (!first) return second;
+    NodeBase *last = first;
+    while (last->right_) last = last->right_;
+    last->right_ = second;
+    return first;
   }
 
-  iterator FindLowerBound(const value_type &key) {
-    BinaryTree *node = this;
-    while (node->data_ && comparator_(node->data_->value, key)) {
-      node = node->right_;
+  // Keeps the first node of every run of equal values in a sorted list.
+  // The list stays intact if the comparator throws.
+  size_type RemoveListDuplicates(NodeBase *list, size_type count) {
+    for (NodeBase *node = list; node && node->right_;) {
+      NodeBase *next = node->right_;
+      if (comparator_(Value(node), Value(next))) {
+        node = next;
+      } else {
+        node->right_ = next->right_;
+        DestroyNode(next);
+        --count;
+      }
     }
-    node = MinimumNode(node);
-    return node ? iterator(node) : end();
+    return count;
   }
 
-  iterator FindUpperBound(const value_type &key) {
-    BinaryTree *node = this;
-    while (node->data_ && !comparator_(node->data_->value, key)) {
-      node = node->left_;
+  // Makes a sorted list of n nodes the whole tree under header, threading
+  // it before BuildBalanced reuses right_.
+  static void BuildTree(NodeBase *header, NodeBase *list,
+                        size_type n) noexcept {
+    NodeBase *prev = header;
+    for (NodeBase *node = list; node; node = node->right_) {
+      prev->next_ = node;
+      node->prev_ = prev;
+      prev = node;
+    }
+    prev->next_ = header;
+    header->prev_ = prev;
+    header->left_ = BuildBalanced(list, n);
+    if (header->left_) header->left_->parent_ = header;
+  }
+
+  // Turns the first n list nodes into a height-balanced subtree in order;
+  // the recursion depth is log2(n).
+  static NodeBase *BuildBalanced(NodeBase *&list, size_type n) noexcept {
+    if (n == 0) return nullptr;
+    NodeBase *left = BuildBalanced(list, n / 2);
+    NodeBase *node = list;
+    list = list->right_;
+    node->left_ = left;
+    if (left) left->parent_ = node;
+    node->right_ = BuildBalanced(list, n - n / 2 - 1);
+    if (node->right_) node->right_->parent_ = node;
+    UpdateNode(node);
+    return node;
+  }
+
+  // Frees a subtree without recursion: a left child is rotated above its
+  // parent until the current node has none, then the node is freed and the
+  // walk moves to its right child. Uses no stack regardless of shape.
+  void DeleteNode(NodeBase *node) noexcept {
+    while (node) {
+      if (NodeBase *left = node->left_) {
+        node->left_ = left->right_;
+        left->right_ = node;
+        node = left;
+      } else {
+        NodeBase *right = node->right_;
+        DestroyNode(node);
+        node = right;
+      }
+    }
+  }
+
+  // Unlinks every node of a subtree into an ascending list chained through
+  // right_ (left_ is left stale), using the mirror image of the stackless
+  // rotation walk in DeleteNode.
+  static NodeBase *DetachNodes(NodeBase *node) noexcept {
+    NodeBase *list = nullptr;
+    while (node) {
+      if (NodeBase *right = node->right_) {
+        node->right_ = right->left_;
+        right->left_ = node;
+        node = right;
+      } else {
+        NodeBase *left = node->left_;
+        node->right_ = list;
+        list = node;
+        node = left;
+      }
+    }
+    return list;
+  }
+
+  void FreeNodeList(NodeBase *list) noexcept {
+    while (list) {
+      NodeBase *next = list->right_;
+      DestroyNode(list);
+      list = next;
+    }
+  }
+
+  // Takes a node from the reuse list, rebuilding its value in place, and
+  // only falls back to the allocator once the list is exhausted.
+  NodeBase *AcquireNode(NodeBase *&reuse, const_reference value,
+                        NodeBase *parent) {
+    if (!reuse) return CreateNode(value, parent);
+    TreeNode *node = static_cast<TreeNode *>(reuse);
+    reuse = reuse->right_;
+    node_traits::destroy(allocator_, node);
+    try {
+      node_traits::construct(allocator_, node, parent, value);
+    } catch (...) {
+      node_traits::deallocate(allocator_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  // Clones other node for node, heights included, walking both trees in
+  // lockstep over parent links: O(n), no comparisons, no recursion. The
+  // copy is only linked under the header once complete.
+  void CopyTree(const NodeBase *other, NodeBase *&reuse) {
+    if (!other) return;
+    NodeBase *root = AcquireNode(reuse, Value(other), &header_);
+    CopyShape(root, other);
+    try {
+      NodeBase *copy = root;
+      const NodeBase *source = other;
+      while (true) {
+        if (source->left_ && !copy->left_) {
+          copy->left_ = AcquireNode(reuse, Value(source->left_), copy);
+          source = source->left_;
+          copy = copy->left_;
+        } else if (source->right_ && !copy->right_) {
+          copy->right_ = AcquireNode(reuse, Value(source->right_), copy);
+          source = source->right_;
+          copy = copy->right_;
+        } else if (source != other) {
+          source = source->parent_;
+          copy = copy->parent_;
+          continue;
+        } else {
+          break;
+        }
+        CopyShape(copy, source);
+      }
+    } catch (...) {
+      DeleteNode(root);
+      throw;
+    }
+    header_.left_ = root;
+    ThreadTree();
+  }
+
+  // Threads the in-order list from the tree shape alone, following parent
+  // links the same way an unthreaded successor search would.
+  void ThreadTree() noexcept {
+    NodeBase *prev = &header_;
+    NodeBase *node = MinimumNode(Root());
+    while (node) {
+      prev->next_ = node;
+      node->prev_ = prev;
+      prev = node;
+      if (node->right_) {
+        node = MinimumNode(node->right_);
+      } else {
+        while (node->parent_ != &header_ && node == node->parent_->right_) {
+          node = node->parent_;
+        }
+        node = node->parent_ == &header_ ? nullptr : node->parent_;
+      }
+    }
+    prev->next_ = &header_;
+    header_.prev_ = prev;
+  }
+
+  std::string InorderTraversal(const NodeBase *node, bool endl) const {
+    if (!node) return "";
+    std::string ans = "";
+    ans += InorderTraversal(node->left_, endl);
+    ans += std::to_string(Value(node)) + ":" +
+           std::to_string(node->height_);
+    ans += ",";
+    if (endl) ans += "\n";
+    ans += InorderTraversal(node->right_, endl);
+    return ans;
+  }
+
+  template <class K>
+  NodeBase *FindNode(const K &value) const {
+    NodeBase *node = Root();
+    while (node) {
+      if (comparator_(value, Value(node))) {
+        node = node->left_;
+      } else if (comparator_(Value(node), value)) {
+        node = node->right_;
+      } else {
+        return node;
+      }
     }
-    node = node->right_;
-    return node ? iterator(node) : end();
+    return nullptr;
   }
 
-  iterator Find(const value_type &value) {
-    BinaryTree *node = FindNode(value);
+  template <class K>
+  iterator Find(const K &value) {
+    NodeBase *node = FindNode(value);
     if (node) {
       return tree_iterator(node);
     } else {
@@ -280,174 +932,738 @@ class BinaryTree {
     }
   }
 
-  void AssignBalanceStatus() {
-    int l = left_ ? left_->height_ : 0;
-    int r = right_ ? right_->height_ : 0;
-    if (l > r) {
-      status_ = BalanceStatus::kLeftHeavy;
-    } else if (l < r) {
-      status_ = BalanceStatus::kRightHeavy;
-    } else if (l == r) {
-      status_ = BalanceStatus::kBalanced;
+  template <class K>
+  iterator FindLowerBound(const K &key) {
+    NodeBase *node = Root();
+    NodeBase *result = &header_;
+    while (node) {
+      if (!comparator_(Value(node), key)) {
+        result = node;
+        node = node->left_;
+      } else {
+        node = node->right_;
+      }
+    }
+    return iterator(result);
+  }
+
+  template <class K>
+  iterator FindUpperBound(const K &key) {
+    NodeBase *node = Root();
+    NodeBase *result = &header_;
+    while (node) {
+      if (comparator_(key, Value(node))) {
+        result = node;
+        node = node->left_;
+      } else {
+        node = node->right_;
+      }
+    }
+    return iterator(result);
+  }
+
+  // Descends to the first element equal to key, then finishes the lower
+  // bound in its left subtree and the upper bound in its right one.
+  template <class K>
+  std::pair<NodeBase *, NodeBase *> EqualRange(const K &key) {
+    NodeBase *node = Root();
+    NodeBase *upper = &header_;
+    while (node) {
+      if (comparator_(key, Value(node))) {
+        upper = node;
+        node = node->left_;
+      } else if (comparator_(Value(node), key)) {
+        node = node->right_;
+      } else {
+        NodeBase *lower = node;
+        for (NodeBase *left = node->left_; left;) {
+          if (comparator_(Value(left), key)) {
+            left = left->right_;
+          } else {
+            lower = left;
+            left = left->left_;
+          }
+        }
+        for (NodeBase *right = node->right_; right;) {
+          if (comparator_(key, Value(right))) {
+            upper = right;
+            right = right->left_;
+          } else {
+            right = right->right_;
+          }
+        }
+        return std::make_pair(lower, upper);
+      }
+    }
+    return std::make_pair(upper, upper);
+  }
+
+  template <class K>
+  size_type CountEqual(const K &key) {
+    std::pair<NodeBase *, NodeBase *> range = EqualRange(key);
+    if constexpr (OrderStatistics) {
+      return IndexOf(range.second) - IndexOf(range.first);
+    } else {
+      size_type count = 0;
+      for (NodeBase *node = range.first; node != range.second; ++count) {
+        node = NextNode(node);
+      }
+      return count;
+    }
+  }
+
+  template <class K>
+  size_type DeleteEqual(const K &key) {
+    std::pair<NodeBase *, NodeBase *> range = EqualRange(key);
+    size_type count = 0;
+    for (NodeBase *node = range.first; node != range.second; ++count) {
+      NodeBase *next = NextNode(node);
+      DeleteByAddress(node);
+      node = next;
+    }
+    return count;
+  }
+
+  size_type DeleteByAddress(NodeBase *node) {
+    if (!node) return 0;
+    UnlinkNode(node);
+    DestroyNode(node);
+    return 1;
+  }
+
+  // Takes node out of the tree and rebalances; the node itself is kept.
+  void UnlinkNode(NodeBase *node) noexcept {
+    node->prev_->next_ = node->next_;
+    node->next_->prev_ = node->prev_;
+    NodeBase *parent = node->parent_;
+    if (node->left_ && node->right_) {
+      parent = SearchAndSwap(node);
+    } else {
+      ReplaceChild(node, node->left_ ? node->left_ : node->right_);
+    }
+    Rebalance(parent);
+  }
+
+  // Unlinks node, which has two children, by moving its in-order predecessor
+  // into its place. Values never move between nodes, so iterators to other
+  // elements stay valid. Returns the lowest node whose height may change.
+  static NodeBase *SearchAndSwap(NodeBase *node) noexcept {
+    NodeBase *pred = MaximumNode(node->left_);
+    NodeBase *lowest = pred;
+    if (pred->parent_ != node) {
+      lowest = pred->parent_;
+      ReplaceChild(pred, pred->left_);
+      pred->left_ = node->left_;
+      pred->left_->parent_ = pred;
+    }
+    pred->right_ = node->right_;
+    pred->right_->parent_ = pred;
+    ReplaceChild(node, pred);
+    CopyShape(pred, node);
+    return lowest;
+  }
+
+  // Links new_child into the slot old_child occupies under its parent. The
+  // root hangs off header_.left_, so no special case is needed for it.
+  static void ReplaceChild(NodeBase *old_child, NodeBase *new_child) noexcept {
+    NodeBase *parent = old_child->parent_;
+    if (parent->left_ == old_child) {
+      parent->left_ = new_child;
+    } else {
+      parent->right_ = new_child;
+    }
+    if (new_child) new_child->parent_ = parent;
+  }
+
+  static int Height(const NodeBase *node) noexcept {
+    return node ? node->height_ : -1;
+  }
+
+  static int BalanceFactor(const NodeBase *node) noexcept {
+    return Height(node->left_) - Height(node->right_);
+  }
+
+  static size_type Size(const NodeBase *node) noexcept {
+    if constexpr (OrderStatistics) {
+      return node ? node->size_ : 0;
+    } else {
+      return 0;
     }
   }
 
-  BinaryTree *RightRotate() {
-    std::swap(data_, left_->data_);
-    std::swap(left_, right_);
-    std::swap(left_, right_->left_);
-    left_->parent_ = this;
-    right_->left_->parent_ = right_;
-    std::swap(right_->left_, right_->right_);
-    right_->UpdateHeight();
-    this->UpdateHeight();
-    return this;
+  // Recomputes height, and subtree size when kept, from the children.
+  static void UpdateNode(NodeBase *node) noexcept {
+    node->height_ = std::max(Height(node->left_), Height(node->right_)) + 1;
+    if constexpr (OrderStatistics) {
+      node->size_ = Size(node->left_) + Size(node->right_) + 1;
+    }
+  }
+
+  static void CopyShape(NodeBase *to, const NodeBase *from) noexcept {
+    to->height_ = from->height_;
+    if constexpr (OrderStatistics) to->size_ = from->size_;
+  }
+
+  static NodeBase *RightRotate(NodeBase *node) noexcept {
+    NodeBase *pivot = node->left_;
+    node->left_ = pivot->right_;
+    if (pivot->right_) pivot->right_->parent_ = node;
+    ReplaceChild(node, pivot);
+    pivot->right_ = node;
+    node->parent_ = pivot;
+    UpdateNode(node);
+    UpdateNode(pivot);
+    return pivot;
+  }
+
+  static NodeBase *LeftRotate(NodeBase *node) noexcept {
+    NodeBase *pivot = node->right_;
+    node->right_ = pivot->left_;
+    if (pivot->left_) pivot->left_->parent_ = node;
+    ReplaceChild(node, pivot);
+    pivot->left_ = node;
+    node->parent_ = pivot;
+    UpdateNode(node);
+    UpdateNode(pivot);
+    return pivot;
   }
 
-  BinaryTree *LeftRotate() {
-    std::swap(data_, right_->data_);
-    std::swap(left_, right_);
-    std::swap(right_, left_->right_);
-    right_->parent_ = this;
-    left_->right_->parent_ = left_;
-    std::swap(left_->left_, left_->right_);
-    left_->UpdateHeight();
-    this->UpdateHeight();
-    return this;
+  static NodeBase *BalanceNode(NodeBase *node) noexcept {
+    UpdateNode(node);
+    int balance = BalanceFactor(node);
+    if (balance > 1) {
+      if (BalanceFactor(node->left_) < 0) LeftRotate(node->left_);
+      return RightRotate(node);
+    } else if (balance < -1) {
+      if (BalanceFactor(node->right_) > 0) RightRotate(node->right_);
+      return LeftRotate(node);
+    }
+    return node;
   }
 
-  void BalanceNode() {
-    if (!IsNodeUnbalanced()) return;
+  // Walks up from node restoring heights and balance, and stops at the
+  // first subtree whose height came out unchanged: nothing above it can
+  // be affected. Subtree sizes still change all the way up to the root.
+  void Rebalance(NodeBase *node) noexcept {
+    while (node != &header_) {
+      int old_height = node->height_;
+      node = BalanceNode(node);
+      if (node->height_ == old_height) break;
+      node = node->parent_;
+    }
+    if constexpr (OrderStatistics) {
+      for (; node != &header_; node = node->parent_) UpdateNode(node);
+    }
+  }
+
+  // Rebalances every node from node up to, not including, top.
+  static void RebalancePath(NodeBase *node, NodeBase *top) noexcept {
+    while (node != top) node = BalanceNode(node)->parent_;
+  }
 
-    if (status_ == BalanceStatus::kLeftHeavy) {
-      if (left_->left_->height_ < left_->right_->height_) {
-        left_->LeftRotate();
+  // Links mid between two detached subtrees whose elements order before
+  // and after it, and returns the root of the balanced result, whose
+  // parent_ is left for the caller to set. The shorter subtree is hung off
+  // the spine of the taller one at the matching height, so the cost is the
+  // height difference, O(|h(left) - h(right)| + 1).
+  static NodeBase *JoinWith(NodeBase *left, NodeBase *mid,
+                            NodeBase *right) noexcept {
+    NodeBase anchor{{}, nullptr, nullptr, nullptr, kHeaderHeight};
+    if (Height(left) > Height(right) + 1) {
+      anchor.left_ = left;
+      left->parent_ = &anchor;
+      NodeBase *parent = left;
+      while (Height(parent->right_) > Height(right) + 1) {
+        parent = parent->right_;
       }
-      RightRotate();
-    } else if (status_ == BalanceStatus::kRightHeavy) {
-      if (right_->right_->height_ < right_->left_->height_) {
-        right_->RightRotate();
+      LinkChildren(mid, parent->right_, right);
+      parent->right_ = mid;
+      mid->parent_ = parent;
+      RebalancePath(parent, &anchor);
+      return anchor.left_;
+    }
+    if (Height(right) > Height(left) + 1) {
+      anchor.left_ = right;
+      right->parent_ = &anchor;
+      NodeBase *parent = right;
+      while (Height(parent->left_) > Height(left) + 1) {
+        parent = parent->left_;
       }
-      LeftRotate();
+      LinkChildren(mid, left, parent->left_);
+      parent->left_ = mid;
+      mid->parent_ = parent;
+      RebalancePath(parent, &anchor);
+      return anchor.left_;
     }
+    LinkChildren(mid, left, right);
+    return mid;
   }
 
-  bool IsNodeUnbalanced() {
-    int l = left_ ? left_->height_ : 0;
-    int r = right_ ? right_->height_ : 0;
-    return std::abs(l - r) > 1;
+  static void LinkChildren(NodeBase *node, NodeBase *left,
+                           NodeBase *right) noexcept {
+    node->left_ = left;
+    node->right_ = right;
+    if (left) left->parent_ = node;
+    if (right) right->parent_ = node;
+    UpdateNode(node);
   }
 
-  void UpdateHeight() {
-    int l = left_ ? left_->height_ : 0;
-    int r = right_ ? right_->height_ : 0;
-    height_ = std::max(l, r) + 1;
+  // Cuts the tree under header before pos and hangs [pos, end) under the
+  // empty header upper. Walking up from pos, every ancestor joins the side
+  // pos is not on together with its other subtree; the join costs telescope
+  // to O(log n) overall. The in-order thread is cut at pos directly.
+  static void SplitAt(NodeBase *header, NodeBase *pos,
+                      NodeBase *upper) noexcept {
+    NodeBase *last_low = pos->prev_;
+    NodeBase *last_high = header->prev_;
+    upper->next_ = pos;
+    pos->prev_ = upper;
+    upper->prev_ = last_high;
+    last_high->next_ = upper;
+    last_low->next_ = header;
+    header->prev_ = last_low;
+
+    NodeBase *parent = pos->parent_;
+    bool from_left = parent->left_ == pos;
+    NodeBase *low = pos->left_;
+    NodeBase *high = JoinWith(nullptr, pos, pos->right_);
+    while (parent != header) {
+      NodeBase *next_parent = parent->parent_;
+      bool next_from_left = next_parent->left_ == parent;
+      if (from_left) {
+        high = JoinWith(high, parent, parent->right_);
+      } else {
+        low = JoinWith(parent->left_, parent, low);
+      }
+      parent = next_parent;
+      from_left = next_from_left;
+    }
+    header->left_ = low;
+    if (low) low->parent_ = header;
+    upper->left_ = high;
+    high->parent_ = upper;
   }
 
-  BinaryTree *SearchAndSwap(BinaryTree *node) {
-    BinaryTree *to_delete = nullptr;
-    if (!node) return to_delete;
-    if (node->left_ && node->left_->data_) {
-      to_delete = node->left_;
-      while (to_delete->right_ && to_delete->right_->data_) {
-        to_delete = to_delete->right_;
+  // Moves every node under high to the end of the tree under low, whose
+  // elements must all order before them, leaving high empty. The first
+  // node of high is taken out to serve as the joining node.
+  static void Append(NodeBase *low, NodeBase *high) noexcept {
+    if (!high->left_) return;
+    if (!low->left_) {
+      MoveHeader(low, high);
+      return;
+    }
+    NodeBase *mid = high->next_;
+    NodeBase *parent = mid->parent_;
+    ReplaceChild(mid, mid->right_);
+    RebalancePath(parent, high);
+    NodeBase *last = low->prev_;
+    last->next_ = mid;
+    mid->prev_ = last;
+    low->prev_ = high->prev_;
+    low->prev_->next_ = low;
+    NodeBase *root = JoinWith(low->left_, mid, high->left_);
+    low->left_ = root;
+    root->parent_ = low;
+    ResetHeader(high);
+  }
+
+  // Single steps a skipping cursor takes before it starts to gallop.
+  static constexpr int kGallopAfter = 4;
+
+  // The first node in [node, end) not less than key, or end. Short skips
+  // stay on the in-order thread; longer ones gallop.
+  const NodeBase *SkipTo(const NodeBase *node, const NodeBase *end,
+                         const_reference key) const noexcept {
+    for (int step = 0; step < kGallopAfter; ++step) {
+      if (node == end || !comparator_(Value(node), key)) return node;
+      node = node->next_;
+    }
+    if (node == end || !comparator_(Value(node), key)) return node;
+    return FingerLowerBound(node, key);
+  }
+
+  // Lower bound of key searched from node, which orders before key: climb
+  // until the next ancestor to the right does not order before key, then
+  // descend from there. For a target d elements away the climb stops after
+  // about log(d) levels.
+  const NodeBase *FingerLowerBound(const NodeBase *node,
+                                   const_reference key) const noexcept {
+    const NodeBase *bound = node->parent_;
+    while (bound->height_ != kHeaderHeight &&
+           (node != bound->left_ || comparator_(Value(bound), key))) {
+      node = bound;
+      bound = node->parent_;
+    }
+    for (const NodeBase *n = node->right_; n;) {
+      if (comparator_(Value(n), key)) {
+        n = n->right_;
+      } else {
+        bound = n;
+        n = n->left_;
       }
-      std::swap(node->data_, to_delete->data_);
-    } else {
-      to_delete = node->right_;
-      std::swap(node->data_, to_delete->data_);
     }
-    return to_delete;
+    return bound;
   }
 
-  std::pair<BinaryTree *, bool> InsertNonUniqueValue(const_reference value) {
-    if (!data_) {
-      data_ = new node_(value);
-      left_ = new BinaryTree(this);
-      right_ = new BinaryTree(this);
-      height_ = 0;
-      AssignBalanceStatus();
-      return std::make_pair(this, true);
-    } else {
-      std::pair<BinaryTree *, bool> ret = {{}, {}};
-      if (comparator_(value, data_->value)) {
-        ret = left_->InsertNonUniqueValue(value);
-      } else if (comparator_(data_->value, value) ||
-                 (!(comparator_(value, data_->value) &&
-                    !comparator_(data_->value, value)))) {
-        ret = right_->InsertNonUniqueValue(value);
-      }
-      height_++;
-      UpdateHeight();
-      AssignBalanceStatus();
-      BalanceNode();
-      return ret;
-    }
-  }
-
-  std::pair<BinaryTree *, bool> InsertValue(const_reference value) {
-    if (!data_) {
-      data_ = new node_(value);
-      left_ = new BinaryTree(this);
-      right_ = new BinaryTree(this);
-      height_ = 0;
-      AssignBalanceStatus();
-      return std::make_pair(this, true);
-    } else if (comparator_(value, data_->value) ||
-               comparator_(data_->value, value)) {
-      std::pair<BinaryTree *, bool> ret = {{}, {}};
-      if (comparator_(value, data_->value)) {
-        ret = left_->InsertValue(value);
-      } else if (comparator_(data_->value, value)) {
-        ret = right_->InsertValue(value);
-      }
-      height_++;
-      UpdateHeight();
-      AssignBalanceStatus();
-      BalanceNode();
-      return ret;
+  const NodeBase *LowerBoundNode(const BinaryTree &tree,
+                                 const_reference key) const noexcept {
+    const NodeBase *bound = &tree.header_;
+    for (const NodeBase *n = tree.Root(); n;) {
+      if (comparator_(Value(n), key)) {
+        n = n->right_;
+      } else {
+        bound = n;
+        n = n->left_;
+      }
+    }
+    return bound;
+  }
+
+  // Runs op over [a, a_end) and [b, b_end), collecting copies of the
+  // result into a list of new nodes chained through right_, the form
+  // AssignRange builds trees from. count is advanced by the list length.
+  NodeBase *SetOperationList(SetOperation op, const NodeBase *a,
+                             const NodeBase *a_end, const NodeBase *b,
+                             const NodeBase *b_end, size_type &count) {
+    bool keep_a = op != SetOperation::kIntersection;
+    bool keep_b = op == SetOperation::kUnion ||
+                  op == SetOperation::kSymmetricDifference;
+    bool keep_equal =
+        op == SetOperation::kUnion || op == SetOperation::kIntersection;
+    NodeBase head{{}, nullptr, nullptr, nullptr, 0};
+    NodeBase *tail = &head;
+    auto emit = [&](const NodeBase *node) {
+      tail->right_ = CreateNode(Value(node), nullptr);
+      tail = tail->right_;
+      ++count;
+    };
+    try {
+      while (a != a_end && b != b_end) {
+        if (comparator_(Value(a), Value(b))) {
+          if (keep_a) {
+            emit(a);
+            a = a->next_;
+          } else {
+            a = SkipTo(a, a_end, Value(b));
+          }
+        } else if (comparator_(Value(b), Value(a))) {
+          if (keep_b) {
+            emit(b);
+            b = b->next_;
+          } else {
+            b = SkipTo(b, b_end, Value(a));
+          }
+        } else {
+          if (keep_equal) emit(a);
+          a = a->next_;
+          b = b->next_;
+        }
+      }
+      for (; keep_a && a != a_end; a = a->next_) emit(a);
+      for (; keep_b && b != b_end; b = b->next_) emit(b);
+    } catch (...) {
+      DeleteNode(head.right_);
+      throw;
+    }
+    return head.right_;
+  }
+
+  // Number of elements from node to the end of a tree of size elements.
+  static size_type CountFrom(NodeBase *node, size_type size) noexcept {
+    if constexpr (OrderStatistics) {
+      return size - IndexOf(node);
     } else {
-      return std::make_pair(this, false);
+      NodeBase *forward = node;
+      NodeBase *backward = node->prev_;
+      for (size_type steps = 0;; ++steps) {
+        if (forward->height_ == kHeaderHeight) return steps;
+        if (backward->height_ == kHeaderHeight) return size - steps;
+        forward = forward->next_;
+        backward = backward->prev_;
+      }
     }
   }
 
-  enum class BalanceStatus {
-    kNone,
-    kBalanced,
-    kLeftHeavy,
-    kRightHeavy,
-  };
+  // Finds the empty link where value belongs, after any equal elements.
+  // With unique set, an equal element ends the search: it is returned in
+  // parent and the result is null.
+  template <class K>
+  NodeBase **FindLink(const K &value, bool unique, NodeBase *&parent) {
+    parent = &header_;
+    NodeBase **link = &header_.left_;
+    while (*link) {
+      parent = *link;
+      if (comparator_(value, Value(parent))) {
+        link = &parent->left_;
+      } else if (!unique || comparator_(Value(parent), value)) {
+        link = &parent->right_;
+      } else {
+        return nullptr;
+      }
+    }
+    return link;
+  }
+
+  // Hangs a detached node on an empty link found by FindLink. A new left
+  // child comes right before its parent in order, a right child right
+  // after; the header counts as a parent with an empty left link.
+  void LinkNode(NodeBase *node, NodeBase *parent, NodeBase **link) noexcept {
+    NodeBase *next = link == &parent->left_ ? parent : parent->next_;
+    node->prev_ = next->prev_;
+    node->next_ = next;
+    next->prev_->next_ = node;
+    next->prev_ = node;
+    node->parent_ = parent;
+    node->left_ = nullptr;
+    node->right_ = nullptr;
+    node->height_ = 0;
+    if constexpr (OrderStatistics) node->size_ = 1;
+    *link = node;
+    Rebalance(parent);
+  }
+
+  // The node is only built once the link is known, so an rvalue is moved
+  // straight into it and a duplicate costs no allocation at all.
+  template <class V>
+  std::pair<NodeBase *, bool> InsertNonUniqueValue(V &&value) {
+    NodeBase *parent = nullptr;
+    NodeBase **link = FindLink(value, false, parent);
+    NodeBase *node = ConstructNode(parent, std::forward<V>(value));
+    LinkNode(node, parent, link);
+    return std::make_pair(node, true);
+  }
+
+  template <class V>
+  std::pair<NodeBase *, bool> InsertValue(V &&value) {
+    NodeBase *parent = nullptr;
+    NodeBase **link = FindLink(value, true, parent);
+    if (!link) return std::make_pair(parent, false);
+    NodeBase *node = ConstructNode(parent, std::forward<V>(value));
+    LinkNode(node, parent, link);
+    return std::make_pair(node, true);
+  }
+
+  template <class V>
+  std::pair<NodeBase *, bool> InsertHinted(NodeBase *hint, V &&value,
+                                           bool unique) {
+    NodeBase *parent = nullptr;
+    NodeBase **link = FindHintLink(hint, value, unique, parent);
+    if (!link) return std::make_pair(parent, false);
+    NodeBase *node = ConstructNode(parent, std::forward<V>(value));
+    LinkNode(node, parent, link);
+    return std::make_pair(node, true);
+  }
+
+  // Whether value can go between the adjacent nodes before and after
+  // (either may be the header) and keep the order; with unique set it must
+  // differ from both.
+  bool FitsBetween(const NodeBase *before, const NodeBase *after,
+                   const_reference value, bool unique) const {
+    if (before != &header_ && (unique ? !comparator_(Value(before), value)
+                                      : comparator_(value, Value(before)))) {
+      return false;
+    }
+    return after == &header_ || (unique ? comparator_(value, Value(after))
+                                        : !comparator_(Value(after), value));
+  }
+
+  // The empty link between adjacent nodes: before's right link if it has
+  // none, otherwise after is the leftmost node of that subtree and its left
+  // link is empty.
+  NodeBase **GapLink(NodeBase *before, NodeBase *after, NodeBase *&parent) {
+    if (before != &header_ && !before->right_) {
+      parent = before;
+      return &before->right_;
+    }
+    parent = after;
+    return &after->left_;
+  }
+
+  // FindLink starting from a hint: the gaps right before and right after
+  // hint are tried first, and an element equal to hint is found at once.
+  NodeBase **FindHintLink(NodeBase *hint, const_reference value, bool unique,
+                          NodeBase *&parent) {
+    if (!hint) return FindLink(value, unique, parent);
+    if (FitsBetween(hint->prev_, hint, value, unique)) {
+      return GapLink(hint->prev_, hint, parent);
+    }
+    if (hint != &header_) {
+      if (FitsBetween(hint, hint->next_, value, unique)) {
+        return GapLink(hint, hint->next_, parent);
+      }
+      if (unique && !comparator_(Value(hint), value) &&
+          !comparator_(value, Value(hint))) {
+        parent = hint;
+        return nullptr;
+      }
+    }
+    return FindLink(value, unique, parent);
+  }
+
+  // Relinks other's nodes one at a time: O(m log(n + m)).
+  size_type MergeByRelinking(BinaryTree &other, bool unique) {
+    size_type moved = 0;
+    NodeBase *node = other.header_.next_;
+    while (node != &other.header_) {
+      NodeBase *next = NextNode(node);
+      NodeBase *parent = nullptr;
+      NodeBase **link = FindLink(Value(node), unique, parent);
+      if (link) {
+        other.UnlinkNode(node);
+        LinkNode(node, parent, link);
+        ++moved;
+      }
+      node = next;
+    }
+    return moved;
+  }
 
-  BinaryTree *parent_;
-  BinaryTree *left_;
-  BinaryTree *right_;
-  BinaryTree *root_child_;
-  int height_;
+  // Flattens both trees into sorted lists, merges them and rebuilds both
+  // balanced: O(n + m). Elements that stay behind go back into other.
+  size_type MergeByRebuilding(BinaryTree &other, bool unique) {
+    NodeBase *mine = DetachNodes(Root());
+    NodeBase *theirs = DetachNodes(other.Root());
+    NodeBase merged{{}, nullptr, nullptr, nullptr, 0};
+    NodeBase kept{{}, nullptr, nullptr, nullptr, 0};
+    NodeBase *merged_tail = &merged;
+    NodeBase *kept_tail = &kept;
+    size_type merged_count = 0;
+    size_type kept_count = 0;
+    size_type moved = 0;
+    while (mine || theirs) {
+      bool take_theirs =
+          !mine || (theirs && comparator_(Value(theirs), Value(mine)));
+      if (!take_theirs && unique && theirs &&
+          !comparator_(Value(mine), Value(theirs))) {
+        kept_tail->right_ = theirs;
+        kept_tail = theirs;
+        theirs = theirs->right_;
+        ++kept_count;
+        continue;
+      }
+      NodeBase *&source = take_theirs ? theirs : mine;
+      merged_tail->right_ = source;
+      merged_tail = source;
+      source = source->right_;
+      ++merged_count;
+      if (take_theirs) ++moved;
+    }
+    merged_tail->right_ = nullptr;
+    kept_tail->right_ = nullptr;
+    BuildTree(&header_, merged.right_, merged_count);
+    BuildTree(&other.header_, kept.right_, kept_count);
+    return moved;
+  }
 
-  static BinaryTree *MinimumNode(BinaryTree *node) {
-    while (node && node->left_ && node->left_->data_) {
+  // Allocators that do not compare equal cannot free each other's nodes,
+  // so those merges copy elements over and erase them from other.
+  size_type MergeByCopying(BinaryTree &other, bool unique) {
+    size_type moved = 0;
+    NodeBase *node = other.header_.next_;
+    while (node != &other.header_) {
+      NodeBase *next = NextNode(node);
+      std::pair<NodeBase *, bool> inserted =
+          unique ? InsertValue(Value(node)) : InsertNonUniqueValue(Value(node));
+      if (inserted.second) {
+        other.DeleteByAddress(node);
+        ++moved;
+      }
+      node = next;
+    }
+    return moved;
+  }
+
+  static NodeBase *MinimumNode(NodeBase *node) noexcept {
+    while (node && node->left_) {
       node = node->left_;
     }
     return node;
   }
-  static BinaryTree *MaximumNode(BinaryTree *node) {
-    while (node && node->right_ && node->right_->data_) {
+
+  static NodeBase *MaximumNode(NodeBase *node) noexcept {
+    while (node && node->right_) {
       node = node->right_;
     }
     return node;
   }
 
-  BalanceStatus status_;
+  static NodeBase *HeaderOf(NodeBase *node) noexcept {
+    while (node && node->height_ != kHeaderHeight) node = node->parent_;
+    return node;
+  }
 
-  struct node_ {
-   public:
-    value_type value;
+  // Position of node in order; the header counts as one past the last.
+  static size_type IndexOf(const NodeBase *node) noexcept {
+    static_assert(OrderStatistics, "s21::tree: order statistics disabled");
+    if (node->height_ == kHeaderHeight) return Size(node->left_);
+    size_type index = Size(node->left_);
+    for (; node->parent_->height_ != kHeaderHeight; node = node->parent_) {
+      if (node == node->parent_->right_) {
+        index += Size(node->parent_->left_) + 1;
+      }
+    }
+    return index;
+  }
+
+  static NodeBase *SelectNode(NodeBase *header, size_type index) noexcept {
+    static_assert(OrderStatistics, "s21::tree: order statistics disabled");
+    NodeBase *node = header->left_;
+    while (node) {
+      size_type left_size = Size(node->left_);
+      if (index < left_size) {
+        node = node->left_;
+      } else if (index > left_size) {
+        index -= left_size + 1;
+        node = node->right_;
+      } else {
+        return node;
+      }
+    }
+    return header;
+  }
+
+  // Moves n positions by rank instead of stepping; out of range ends up on
+  // the header.
+  static NodeBase *Advance(NodeBase *node, std::ptrdiff_t n) noexcept {
+    if (!node) return node;
+    return SelectNode(HeaderOf(node), IndexOf(node) + n);
+  }
 
-    node_(value_type value) noexcept : value(value){};
+  // In-order successor; the last element steps onto the header and the
+  // header stays put.
+  static NodeBase *NextNode(NodeBase *node) noexcept {
+    if (!node || node->height_ == kHeaderHeight) return node;
+    return node->next_;
+  }
+
+  // In-order predecessor; stepping back from the header yields the last
+  // element.
+  static NodeBase *PrevNode(NodeBase *node) noexcept {
+    return node ? node->prev_ : node;
+  }
+
+  struct NodeBase : TreeNodeSize<OrderStatistics> {
+    NodeBase *parent_;
+    NodeBase *left_;
+    NodeBase *right_;
+    int height_;
+    NodeBase *prev_ = nullptr;
+    NodeBase *next_ = nullptr;
+  };
+
+  struct TreeNode : NodeBase {
+    template <class... Args>
+    explicit TreeNode(NodeBase *parent, Args &&...args)
+        : NodeBase{{}, parent, nullptr, nullptr, 0},
+          value_(std::forward<Args>(args)...) {}
+
+    value_type value_;
   };
 
-  node_ *data_;
+  NodeBase header_;
   Comparator comparator_;
+  node_allocator allocator_;
 
  public:
   struct tree_iterator {
@@ -461,7 +1677,7 @@ class BinaryTree {
 
     tree_iterator() { tree_ = nullptr; }
 
-    explicit tree_iterator(BinaryTree *tree) { tree_ = tree; }
+    explicit tree_iterator(NodeBase *tree) { tree_ = tree; }
 
     tree_iterator(const tree_iterator &other) { *this = other; }
 
@@ -472,75 +1688,30 @@ class BinaryTree {
 
     ~tree_iterator() { tree_ = nullptr; }
 
-    tree_iterator begin() { return tree_iterator(MinimumNode(tree_)); }
-
-    tree_iterator end() {
-      BinaryTree *node = tree_;
-      while (node && node->height_ != -2) node = node->parent_;
-      return tree_iterator(node);
+    tree_iterator begin() {
+      NodeBase *header = HeaderOf(tree_);
+      return tree_iterator(header ? header->next_ : header);
     }
 
-    bool is_null() { return tree_ == nullptr || tree_->data_ == nullptr; }
-
-    BinaryTree *data() { return tree_; }
+    tree_iterator end() { return tree_iterator(HeaderOf(tree_)); }
 
-    std::pair<BinaryTree *, bool> next_node(BinaryTree *res) {
-      if (!res || res->height_ == -2) return std::make_pair(res, true);
-      if (res->right_ && !res->right_->data_) {
-        while (res && res->parent_ && res->parent_->left_ != res) {
-          if (res->height_ == -2) return std::make_pair(res, true);
-          res = res->parent_;
-        }
-        if (res->parent_) res = res->parent_;
-      } else {
-        res = res->right_;
-        while (res && res->left_ && res->left_->data_) {
-          res = res->left_;
-        }
-      }
-      return std::make_pair(res, false);
+    bool is_null() const {
+      return tree_ == nullptr || tree_->height_ == kHeaderHeight;
     }
 
-    std::pair<BinaryTree *, bool> prev_node(BinaryTree *res) {
-      if (res->root_child_) {
-        res = res->root_child_;
-        while (res && res->right_ && res->right_->data_) res = res->right_;
-        return std::make_pair(res, false);
-      }
-      if (res->left_ && res->left_->data_) {
-        res = res->left_;
-        while (res->right_->data_) {
-          res = res->right_;
-        }
-      } else {
-        if (res->parent_->right_ == res) {
-          return std::make_pair(res->parent_, false);
-        } else if (res->parent_->left_ == res) {
-          while (res->parent_->right_ != res) {
-            res = res->parent_;
-            if (res->height_ == -2)
-              return std::make_pair(res->root_child_, false);
-          }
-          if (res->parent_->right_ == res) res = res->parent_;
-        }
-      }
-      return std::make_pair(res, false);
-    }
+    NodeBase *data() { return tree_; }
 
     local_value_type &operator*() const {
-      if (!tree_ || !tree_->data_) {
+      if (is_null()) {
         throw std::runtime_error("s21::tree::operator*: No value");
       }
-      return tree_->data_->value;
+      return Value(tree_);
     }
 
+    pointer operator->() const { return &**this; }
+
     tree_iterator &operator++() noexcept {
-      std::pair<BinaryTree *, bool> next = next_node(tree_);
-      if (next.second == true) {
-        *this = end();
-      } else {
-        tree_ = next.first;
-      }
+      tree_ = NextNode(tree_);
       return *this;
     }
 
@@ -551,7 +1722,7 @@ class BinaryTree {
     }
 
     tree_iterator &operator--() noexcept {
-      tree_ = prev_node(tree_).first;
+      tree_ = PrevNode(tree_);
       return *this;
     }
 
@@ -561,13 +1732,36 @@ class BinaryTree {
       return temp;
     }
 
+    // Random-access style moves, O(log n) with OrderStatistics.
+    tree_iterator &operator+=(difference_type n) noexcept {
+      tree_ = Advance(tree_, n);
+      return *this;
+    }
+
+    tree_iterator &operator-=(difference_type n) noexcept {
+      return *this += -n;
+    }
+
+    tree_iterator operator+(difference_type n) const noexcept {
+      tree_iterator temp{tree_};
+      return temp += n;
+    }
+
+    tree_iterator operator-(difference_type n) const noexcept {
+      tree_iterator temp{tree_};
+      return temp -= n;
+    }
+
+    difference_type operator-(const tree_iterator &other) const noexcept {
+      return static_cast<difference_type>(IndexOf(tree_)) -
+             static_cast<difference_type>(IndexOf(other.tree_));
+    }
+
     tree_iterator &operator=(const tree_iterator &other) {
       tree_ = other.tree_;
       return *this;
     }
 
-    BinaryTree *operator->() { return tree_; }
-
     bool operator==(const tree_iterator &other) const noexcept {
       return tree_ == other.tree_;
     }
@@ -577,7 +1771,7 @@ class BinaryTree {
     }
 
    private:
-    BinaryTree *tree_;
+    NodeBase *tree_;
   };
 
   struct tree_const_iterator {
@@ -585,13 +1779,13 @@ class BinaryTree {
     using difference_type = std::ptrdiff_t;
 
     using value_type = BinaryTree::value_type;
-    using local_value_type = value_type;
+    using local_value_type = const value_type;
     using pointer = local_value_type *;
     using reference = local_value_type &;
 
     tree_const_iterator() { tree_ = nullptr; }
 
-    explicit tree_const_iterator(BinaryTree *tree) { tree_ = tree; }
+    explicit tree_const_iterator(NodeBase *tree) { tree_ = tree; }
 
     tree_const_iterator(const tree_const_iterator &other) { *this = other; }
 
@@ -603,76 +1797,29 @@ class BinaryTree {
     ~tree_const_iterator() { tree_ = nullptr; }
 
     tree_const_iterator begin() {
-      return tree_const_iterator(MinimumNode(tree_));
-    }
-
-    tree_const_iterator end() {
-      BinaryTree *node = tree_;
-      while (node && node->height_ != -2) node = node->parent_;
-      return tree_const_iterator(node);
+      NodeBase *header = HeaderOf(tree_);
+      return tree_const_iterator(header ? header->next_ : header);
     }
 
-    bool is_null() { return tree_ == nullptr || tree_->data_ == nullptr; }
+    tree_const_iterator end() { return tree_const_iterator(HeaderOf(tree_)); }
 
-    BinaryTree *data() { return tree_; }
-
-    std::pair<BinaryTree *, bool> next_node(BinaryTree *res) {
-      if (!res || res->height_ == -2) return std::make_pair(res, true);
-      if (res->right_ && !res->right_->data_) {
-        while (res && res->parent_ && res->parent_->left_ != res) {
-          if (res->height_ == -2) return std::make_pair(res, true);
-          res = res->parent_;
-        }
-        if (res->parent_) res = res->parent_;
-      } else {
-        res = res->right_;
-        while (res && res->left_ && res->left_->data_) {
-          res = res->left_;
-        }
-      }
-      return std::make_pair(res, false);
+    bool is_null() const {
+      return tree_ == nullptr || tree_->height_ == kHeaderHeight;
     }
 
-    std::pair<BinaryTree *, bool> prev_node(BinaryTree *res) {
-      if (res->root_child_) {
-        res = res->root_child_;
-        while (res && res->right_ && res->right_->data_) res = res->right_;
-        return std::make_pair(res, false);
-      }
-      if (res->left_ && res->left_->data_) {
-        res = res->left_;
-        while (res->right_->data_) {
-          res = res->right_;
-        }
-      } else {
-        if (res->parent_->right_ == res) {
-          return std::make_pair(res->parent_, false);
-        } else if (res->parent_->left_ == res) {
-          while (res->parent_->right_ != res) {
-            res = res->parent_;
-            if (res->height_ == -2)
-              return std::make_pair(res->root_child_, false);
-          }
-          if (res->parent_->right_ == res) res = res->parent_;
-        }
-      }
-      return std::make_pair(res, false);
-    }
+    NodeBase *data() { return tree_; }
 
     local_value_type &operator*() const {
-      if (!tree_ || !tree_->data_) {
+      if (is_null()) {
         throw std::runtime_error("s21::tree::operator*: No value");
       }
-      return tree_->data_->value;
+      return Value(tree_);
     }
 
+    pointer operator->() const { return &**this; }
+
     tree_const_iterator &operator++() noexcept {
-      std::pair<BinaryTree *, bool> next = next_node(tree_);
-      if (next.second == true) {
-        *this = end();
-      } else {
-        tree_ = next.first;
-      }
+      tree_ = NextNode(tree_);
       return *this;
     }
 
@@ -683,7 +1830,7 @@ class BinaryTree {
     }
 
     tree_const_iterator &operator--() noexcept {
-      tree_ = prev_node(tree_).first;
+      tree_ = PrevNode(tree_);
       return *this;
     }
 
@@ -693,13 +1840,36 @@ class BinaryTree {
       return temp;
     }
 
+    // Random-access style moves, O(log n) with OrderStatistics.
+    tree_const_iterator &operator+=(difference_type n) noexcept {
+      tree_ = Advance(tree_, n);
+      return *this;
+    }
+
+    tree_const_iterator &operator-=(difference_type n) noexcept {
+      return *this += -n;
+    }
+
+    tree_const_iterator operator+(difference_type n) const noexcept {
+      tree_const_iterator temp{tree_};
+      return temp += n;
+    }
+
+    tree_const_iterator operator-(difference_type n) const noexcept {
+      tree_const_iterator temp{tree_};
+      return temp -= n;
+    }
+
+    difference_type operator-(const tree_const_iterator &other) const noexcept {
+      return static_cast<difference_type>(IndexOf(tree_)) -
+             static_cast<difference_type>(IndexOf(other.tree_));
+    }
+
     tree_const_iterator &operator=(const tree_const_iterator &other) {
       tree_ = other.tree_;
       return *this;
     }
 
-    BinaryTree *operator->() { return tree_; }
-
     bool operator==(const tree_const_iterator &other) const noexcept {
       return tree_ == other.tree_;
     }
@@ -709,7 +1879,97 @@ class BinaryTree {
     }
 
    private:
-    BinaryTree *tree_;
+    NodeBase *tree_;
+  };
+
+  // Owns a node taken out of a tree by extract(), element and all, until
+  // it is linked into a tree again or destroyed with the handle. The
+  // element can be changed in between, key included, since it is not
+  // ordered in any tree while the handle holds it.
+  class node_handle {
+   public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    node_handle() noexcept = default;
+
+    node_handle(node_handle &&other) noexcept
+        : node_(std::exchange(other.node_, nullptr)),
+          allocator_(std::move(other.allocator_)) {
+      other.allocator_.reset();
+    }
+
+    node_handle &operator=(node_handle &&other) noexcept {
+      if (this != &other) {
+        Reset();
+        node_ = std::exchange(other.node_, nullptr);
+        if (other.allocator_) allocator_.emplace(std::move(*other.allocator_));
+        other.allocator_.reset();
+      }
+      return *this;
+    }
+
+    ~node_handle() noexcept { Reset(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    allocator_type get_allocator() const {
+      return allocator_type(*allocator_);
+    }
+
+    value_type &value() const noexcept { return Value(node_); }
+
+    // Map elements: the key is writable here, unlike through an iterator.
+    template <class V = T>
+    std::remove_const_t<typename V::first_type> &key() const noexcept {
+      return const_cast<std::remove_const_t<typename V::first_type> &>(
+          Value(node_).first);
+    }
+
+    template <class V = T>
+    typename V::second_type &mapped() const noexcept {
+      return Value(node_).second;
+    }
+
+    void swap(node_handle &other) noexcept {
+      node_handle tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+
+   private:
+    friend class BinaryTree;
+
+    node_handle(NodeBase *node, const node_allocator &allocator)
+        : node_(node), allocator_(allocator) {}
+
+    NodeBase *Release() noexcept {
+      allocator_.reset();
+      return std::exchange(node_, nullptr);
+    }
+
+    void Reset() noexcept {
+      if (node_) {
+        TreeNode *tree_node = static_cast<TreeNode *>(node_);
+        node_traits::destroy(*allocator_, tree_node);
+        node_traits::deallocate(*allocator_, tree_node, 1);
+        node_ = nullptr;
+      }
+      allocator_.reset();
+    }
+
+    NodeBase *node_ = nullptr;
+    std::optional<node_allocator> allocator_;
+  };
+
+  // What inserting a node handle into a unique tree reports, as in the
+  // standard containers: node is empty unless inserted is false.
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_handle node;
   };
 };
 }  // namespace s21
@@ -0,0 +1,233 @@
+#ifndef SRC_S21_UNORDERED_MAP_H
+#define SRC_S21_UNORDERED_MAP_H
+
+#include <functional>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+// Hash map backed by the open-addressing HashTable; see unordered_set.
+// Pairs are stored inline in the slot array, so a hit reads the key and
+// the mapped value from the same cache line.
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+ public:
+  // in-class type overrides
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using table_type =
+      HashTable<Key, value_type, HashSelectFirst, Hash, KeyEqual, Allocator>;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  // main methods for interacting with the class
+  unordered_map() = default;
+
+  explicit unordered_map(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &alloc = Allocator())
+      : table_(bucket_count, hash, equal, alloc) {}
+
+  explicit unordered_map(const Allocator &alloc)
+      : table_(0, Hash(), KeyEqual(), alloc) {}
+
+  unordered_map(std::initializer_list<value_type> const &items,
+                const Allocator &alloc = Allocator())
+      : unordered_map(items.begin(), items.end(), alloc) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  unordered_map(InputIt first, InputIt last,
+                const Allocator &alloc = Allocator())
+      : table_(0, Hash(), KeyEqual(), alloc) {
+    insert(first, last);
+  }
+
+  allocator_type get_allocator() const { return table_.get_allocator(); }
+
+  hasher hash_function() const { return table_.hash_function(); }
+
+  key_equal key_eq() const { return table_.key_eq(); }
+
+  // methods for accessing the elements of the class
+  mapped_type &at(const key_type &key) { return FindByKey(key); }
+
+  const mapped_type &at(const key_type &key) const { return FindByKey(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  mapped_type &at(const K &key) {
+    return FindByKey(key);
+  }
+
+  mapped_type &operator[](const key_type &key) {
+    return try_emplace(key).first->second;
+  }
+
+  // methods for iterating over class elements (access to iterator)
+  iterator begin() { return table_.begin(); }
+
+  iterator end() { return table_.end(); }
+
+  const_iterator begin() const { return table_.cbegin(); }
+
+  const_iterator end() const { return table_.cend(); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return table_.empty(); }
+
+  size_type size() const noexcept { return table_.size(); }
+
+  size_type max_size() const noexcept { return table_.max_size(); }
+
+  // hash policy
+  size_type bucket_count() const noexcept { return table_.bucket_count(); }
+
+  float load_factor() const noexcept { return table_.load_factor(); }
+
+  float max_load_factor() const noexcept { return table_.max_load_factor(); }
+
+  void max_load_factor(float ml) { table_.max_load_factor(ml); }
+
+  void rehash(size_type bucket_count) { table_.rehash(bucket_count); }
+
+  void reserve(size_type count) { table_.reserve(count); }
+
+  // methods for modifying a container
+  void clear() { table_.clear(); }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return table_.emplace_unique(value.first, value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return table_.emplace_unique(value.first, std::move(value));
+  }
+
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj) {
+    return try_emplace(key, obj);
+  }
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const key_type &key,
+                                             const mapped_type &obj) {
+    std::pair<iterator, bool> ret = try_emplace(key, obj);
+    if (!ret.second) ret.first->second = obj;
+    return ret;
+  }
+
+  // Builds the mapped value from args only when key is absent.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return table_.emplace_unique(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  size_type erase(const key_type &key) { return table_.erase_key(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  size_type erase(const K &key) {
+    return table_.erase_key(key);
+  }
+
+  void erase(iterator pos) { table_.erase(pos); }
+
+  void erase(const_iterator pos) { table_.erase(pos); }
+
+  // Moves over the elements whose key is not present yet; the rest stay
+  // in other.
+  void merge(unordered_map &other) {
+    if (this == &other) return;
+    for (iterator it = other.begin(); it != other.end();) {
+      iterator next = it;
+      ++next;
+      if (!contains(it->first)) {
+        insert(std::move(*it));
+        other.erase(it);
+      }
+      it = next;
+    }
+  }
+
+  void swap(unordered_map &other) { table_.swap(other.table_); }
+
+  // methods for viewing the container
+  size_type count(const key_type &key) const {
+    return table_.contains(key) ? 1 : 0;
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  size_type count(const K &key) const {
+    return table_.contains(key) ? 1 : 0;
+  }
+
+  iterator find(const key_type &key) { return table_.find(key); }
+
+  const_iterator find(const key_type &key) const { return table_.find(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  iterator find(const K &key) {
+    return table_.find(key);
+  }
+
+  bool contains(const key_type &key) const { return table_.contains(key); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  bool contains(const K &key) const {
+    return table_.contains(key);
+  }
+
+ private:
+  template <class K>
+  mapped_type &FindByKey(const K &key) {
+    iterator it = table_.find(key);
+    if (it == table_.end()) throw std::out_of_range("Key is not in the map");
+    return it->second;
+  }
+
+  template <class K>
+  const mapped_type &FindByKey(const K &key) const {
+    const_iterator it = table_.find(key);
+    if (it == table_.end()) throw std::out_of_range("Key is not in the map");
+    return it->second;
+  }
+
+  table_type table_;
+};
+
+namespace pmr {
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+using unordered_map = s21::unordered_map<
+    Key, T, Hash, KeyEqual,
+    std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_UNORDERED_MAP_H
@@ -0,0 +1,174 @@
+#ifndef SRC_S21_UNORDERED_SET_H
+#define SRC_S21_UNORDERED_SET_H
+
+#include <functional>
+#include <memory_resource>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+// Hash set backed by the open-addressing HashTable. Lookups cost one hash
+// and, typically, one group of control bytes plus one slot, instead of
+// O(log n) comparisons. Lookups by another key type need both Hash and
+// KeyEqual to declare is_transparent.
+template <class T, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>,
+          class Allocator = std::allocator<T>>
+class unordered_set {
+ public:
+  // in-class type overrides
+  using key_type = T;
+  using value_type = T;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = T &;
+  using const_reference = const T &;
+  using table_type =
+      HashTable<T, T, HashIdentity, Hash, KeyEqual, Allocator>;
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  // main methods for interacting with the class
+  unordered_set() = default;
+
+  explicit unordered_set(size_type bucket_count, const Hash &hash = Hash(),
+                         const KeyEqual &equal = KeyEqual(),
+                         const Allocator &alloc = Allocator())
+      : table_(bucket_count, hash, equal, alloc) {}
+
+  explicit unordered_set(const Allocator &alloc)
+      : table_(0, Hash(), KeyEqual(), alloc) {}
+
+  unordered_set(std::initializer_list<value_type> const &items,
+                const Allocator &alloc = Allocator())
+      : unordered_set(items.begin(), items.end(), alloc) {}
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  unordered_set(InputIt first, InputIt last,
+                const Allocator &alloc = Allocator())
+      : table_(0, Hash(), KeyEqual(), alloc) {
+    insert(first, last);
+  }
+
+  allocator_type get_allocator() const { return table_.get_allocator(); }
+
+  hasher hash_function() const { return table_.hash_function(); }
+
+  key_equal key_eq() const { return table_.key_eq(); }
+
+  // methods for iterating over class elements (access to iterators)
+  iterator begin() const { return table_.cbegin(); }
+
+  iterator end() const { return table_.cend(); }
+
+  // methods for accessing the container capacity information
+  bool empty() const noexcept { return table_.empty(); }
+
+  size_type size() const noexcept { return table_.size(); }
+
+  size_type max_size() const noexcept { return table_.max_size(); }
+
+  // hash policy
+  size_type bucket_count() const noexcept { return table_.bucket_count(); }
+
+  float load_factor() const noexcept { return table_.load_factor(); }
+
+  float max_load_factor() const noexcept { return table_.max_load_factor(); }
+
+  void max_load_factor(float ml) { table_.max_load_factor(ml); }
+
+  void rehash(size_type bucket_count) { table_.rehash(bucket_count); }
+
+  void reserve(size_type count) { table_.reserve(count); }
+
+  // methods for modifying a container
+  void clear() { table_.clear(); }
+
+  std::pair<iterator, bool> insert(const_reference value) {
+    return table_.emplace_unique(value, value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return table_.emplace_unique(value, std::move(value));
+  }
+
+  template <class InputIt, class = RequireInputIterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  size_type erase(const T &value) { return table_.erase_key(value); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  size_type erase(const K &key) {
+    return table_.erase_key(key);
+  }
+
+  void erase(iterator pos) { table_.erase(pos); }
+
+  // Moves over the elements whose key is not present yet; the rest stay
+  // in other.
+  void merge(unordered_set &other) {
+    if (this == &other) return;
+    for (iterator it = other.begin(); it != other.end();) {
+      iterator next = it;
+      ++next;
+      if (!contains(*it)) {
+        insert(std::move(const_cast<value_type &>(*it)));
+        other.erase(it);
+      }
+      it = next;
+    }
+  }
+
+  void swap(unordered_set &other) { table_.swap(other.table_); }
+
+  // methods for viewing the container
+  size_type count(const_reference value) const {
+    return table_.contains(value) ? 1 : 0;
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  size_type count(const K &key) const {
+    return table_.contains(key) ? 1 : 0;
+  }
+
+  iterator find(const_reference value) const { return table_.find(value); }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  iterator find(const K &key) const {
+    return table_.find(key);
+  }
+
+  bool contains(const_reference value) const {
+    return table_.contains(value);
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual,
+            class = RequireTransparent<H>, class = RequireTransparent<E>>
+  bool contains(const K &key) const {
+    return table_.contains(key);
+  }
+
+ private:
+  table_type table_;
+};
+
+namespace pmr {
+template <class T, class Hash = std::hash<T>,
+          class KeyEqual = std::equal_to<T>>
+using unordered_set = s21::unordered_set<T, Hash, KeyEqual,
+                                         std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_UNORDERED_SET_H
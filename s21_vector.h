@@ -169,6 +169,14 @@ class vector {
     arr_[size_ - 1] = value;
   }
 
+  void push_back(value_type &&value) {
+    if (size_ == capacity_) {
+      reserve(size_ == 0 ? 1 : capacity_ * 2);
+    }
+    size_++;
+    arr_[size_ - 1] = std::move(value);
+  }
+
   void pop_back() {
     if (size_ == 0) throw std::out_of_range("Container is empty");
     size_--;
@@ -1,11 +1,18 @@
 #include <gtest/gtest.h>
 
 #include "test_avl_tree.cc"
+#include "test_btree.cc"
+#include "test_concurrent_map.cc"
+#include "test_counted_multiset.cc"
+#include "test_flat.cc"
 #include "test_lists.cc"
 #include "test_map.cc"
+#include "test_persistent_map.cc"
 #include "test_queue.cc"
 #include "test_set.cc"
+#include "test_set_algebra.cc"
 #include "test_stack.cc"
+#include "test_unordered.cc"
 #include "test_vector.cc"
 //#include "test_multiset.cc"
 #include "test_another_vector.cc"
@@ -176,3 +176,236 @@ TEST_F(AvlTreeTest, IteratorBeginEnd) {
   EXPECT_NO_THROW(auto it = my_container->begin();
                   while (it != my_container->end()) { ++it; });
 }
+
+TEST(AvlTreeSuite, EmptyTreeBeginIsEnd) {
+  s21::BinaryTree<int, std::less<int>> my_container;
+  EXPECT_TRUE(my_container.begin() == my_container.end());
+  EXPECT_TRUE(my_container.begin().is_null());
+  EXPECT_EQ(my_container.inorder_traversal(false), "");
+}
+
+TEST_F(AvlTreeTest, DeleteAllAndReinsert) {
+  my_container->del(2);
+  my_container->del(1);
+  my_container->del(5);
+  EXPECT_TRUE(my_container->begin() == my_container->end());
+  for (int i = 0; i < 7; ++i) my_container->insert(i);
+  std::string expected = "0:0,1:1,2:0,3:2,4:0,5:1,6:0,";
+  EXPECT_EQ(my_container->inorder_traversal(false), expected);
+  int i = 0;
+  for (auto it = my_container->begin(); it != my_container->end(); ++it) {
+    EXPECT_EQ(*it, i++);
+  }
+  EXPECT_EQ(i, 7);
+}
+
+TEST(AvlTreeSuite, EraseKeepsBalance) {
+  s21::BinaryTree<int, std::less<int>> my_container;
+  for (int i = 0; i < 7; ++i) my_container.insert(i);
+  my_container.del(4);
+  my_container.del(6);
+  my_container.del(5);
+  std::string expected = "0:0,1:2,2:0,3:1,";
+  EXPECT_EQ(my_container.inorder_traversal(false), expected);
+  my_container.del(3);
+  expected = "0:0,1:1,2:0,";
+  EXPECT_EQ(my_container.inorder_traversal(false), expected);
+}
+
+TEST(AvlTreeSuite, ChurnKeepsLogHeight) {
+  s21::BinaryTree<int, std::less<int>> my_container;
+  const int n = 4096;
+  for (int i = 0; i < n; ++i) my_container.insert(i);
+  for (int round = 0; round < 8; ++round) {
+    for (int i = round % 2; i < n; i += 2) my_container.del(i);
+    for (int i = round % 2; i < n; i += 2) my_container.insert(i + n);
+    for (int i = round % 2; i < n; i += 2) my_container.del(i + n);
+    for (int i = round % 2; i < n; i += 2) my_container.insert(i);
+  }
+  for (int i = 0; i < n / 2; ++i) my_container.del(i);
+  // AVL bound: height < 1.4405 * log2(n + 2) - 0.3277.
+  EXPECT_LE(my_container.height(),
+            static_cast<int>(1.4405 * std::log2(n / 2 + 2)));
+  int expected = n / 2;
+  for (auto it = my_container.begin(); it != my_container.end(); ++it) {
+    EXPECT_EQ(*it, expected++);
+  }
+  EXPECT_EQ(expected, n);
+}
+
+TEST(AvlTreeSuite, AssignSortedIsBalanced) {
+  s21::BinaryTree<int, std::less<int>> my_container;
+  std::vector<int> values;
+  for (int i = 0; i < 1023; ++i) values.push_back(i);
+  EXPECT_EQ(my_container.assign_sorted(values.begin(), values.end()), 1023U);
+  EXPECT_EQ(my_container.height(), 9);
+  values = {7, 3, 5, 3, 1};
+  EXPECT_EQ(my_container.assign_sorted(values.begin(), values.end()), 4U);
+  EXPECT_EQ(my_container.inorder_traversal(false), "1:0,3:1,5:2,7:0,");
+  EXPECT_EQ(
+      my_container.assign_sorted_non_unique(values.begin(), values.end()), 5U);
+  EXPECT_EQ(my_container.inorder_traversal(false), "1:0,3:1,3:2,5:0,7:1,");
+}
+
+TEST(AvlTreeSuite, CopyKeepsShape) {
+  s21::BinaryTree<int, std::less<int>> my_container;
+  for (int i = 0; i < 100; ++i) my_container.insert((i * 37) % 100);
+  for (int i = 0; i < 100; i += 3) my_container.del(i);
+  s21::BinaryTree<int, std::less<int>> copy(my_container);
+  EXPECT_EQ(copy.inorder_traversal(false),
+            my_container.inorder_traversal(false));
+  s21::BinaryTree<int, std::less<int>> assigned;
+  for (int i = 0; i < 10; ++i) assigned.insert(-i);
+  assigned = my_container;
+  EXPECT_EQ(assigned.inorder_traversal(false),
+            my_container.inorder_traversal(false));
+  s21::BinaryTree<int, std::less<int>> empty;
+  assigned = empty;
+  EXPECT_TRUE(assigned.begin() == assigned.end());
+  copy.insert(1000);
+  EXPECT_EQ(*--copy.end(), 1000);
+  EXPECT_EQ(*--my_container.end(), 98);
+}
+
+TEST(AvlTreeSuite, OrderStatisticsSurviveChurn) {
+  s21::BinaryTree<int, std::less<int>, std::allocator<int>, true> my_container;
+  std::vector<int> present;
+  for (int i = 0; i < 500; ++i) my_container.insert((i * 211) % 500);
+  for (int i = 0; i < 500; i += 3) my_container.del((i * 7) % 500);
+  for (int i = 0; i < 500; ++i) {
+    if (my_container.contains(i)) present.push_back(i);
+  }
+  for (size_t i = 0; i < present.size(); ++i) {
+    EXPECT_EQ(*my_container.select(i), present[i]);
+    EXPECT_EQ(my_container.rank(present[i]), i);
+  }
+  EXPECT_TRUE(my_container.select(present.size()) == my_container.end());
+  s21::BinaryTree<int, std::less<int>, std::allocator<int>, true> copy(
+      my_container);
+  copy.insert(-1);
+  EXPECT_EQ(*copy.select(0), -1);
+  EXPECT_EQ(my_container.rank(1000), present.size());
+  EXPECT_EQ(copy.rank(1000), present.size() + 1);
+}
+
+TEST(AvlTreeSuite, OrderStatisticsIteratorJumps) {
+  s21::BinaryTree<int, std::less<int>, std::allocator<int>, true> my_container;
+  std::vector<int> values;
+  for (int i = 0; i < 100; ++i) values.push_back(i * 2);
+  my_container.assign_sorted(values.begin(), values.end());
+  auto it = my_container.begin();
+  it += 10;
+  EXPECT_EQ(*it, 20);
+  EXPECT_EQ(*(it + 5), 30);
+  EXPECT_EQ(*(it - 10), 0);
+  EXPECT_EQ(it - my_container.begin(), 10);
+  EXPECT_EQ(my_container.end() - it, 90);
+  EXPECT_TRUE(it + 90 == my_container.end());
+  EXPECT_EQ(*(my_container.end() - 1), 198);
+  EXPECT_EQ(my_container.count_range(10, 20), 5U);
+  EXPECT_EQ(my_container.count_range(20, 10), 0U);
+}
+
+TEST(AvlTreeSuite, IterationFollowsEveryUpdate) {
+  s21::BinaryTree<int, std::less<int>> my_container;
+  std::map<int, int> reference;
+  for (int i = 0; i < 300; ++i) {
+    int key = (i * 97) % 211;
+    my_container.insert(key);
+    reference[key] = key;
+    if (i % 3 == 0) {
+      my_container.del((i * 13) % 211);
+      reference.erase((i * 13) % 211);
+    }
+  }
+  s21::BinaryTree<int, std::less<int>> copy(my_container);
+  for (auto* tree : {&my_container, &copy}) {
+    auto std_p = reference.begin();
+    for (auto it = tree->begin(); it != tree->end(); ++it, ++std_p) {
+      EXPECT_EQ(*it, std_p->first);
+    }
+    EXPECT_TRUE(std_p == reference.end());
+    auto std_r = reference.rbegin();
+    for (auto it = tree->end(); it != tree->begin(); ++std_r) {
+      EXPECT_EQ(*--it, std_r->first);
+    }
+    EXPECT_TRUE(std_r == reference.rend());
+  }
+}
+
+TEST(AvlTreeSuite, SplitAndJoinKeepBalance) {
+  using Tree = s21::BinaryTree<int, std::less<int>, std::allocator<int>, true>;
+  const int n = 1000;
+  for (int cut = 0; cut <= n; cut += 37) {
+    Tree low;
+    for (int i = 0; i < n; ++i) low.insert((i * 389) % n);
+    Tree high;
+    EXPECT_EQ(low.split(low.lower_bound(cut), high, n),
+              static_cast<size_t>(n - cut));
+    EXPECT_LE(low.height(), static_cast<int>(1.4405 * std::log2(n + 2)));
+    EXPECT_LE(high.height(), static_cast<int>(1.4405 * std::log2(n + 2)));
+    for (int i = 0; i < cut; ++i) EXPECT_EQ(*low.select(i), i);
+    for (int i = cut; i < n; ++i) EXPECT_EQ(*high.select(i - cut), i);
+    EXPECT_EQ(low.rank(n), static_cast<size_t>(cut));
+    Tree spanning;
+    spanning.insert(-1);
+    spanning.insert(n);
+    if (cut > 0) {
+      EXPECT_THROW(low.join(spanning, true), std::invalid_argument);
+    }
+    Tree &whole = cut % 2 ? low : high;
+    Tree &emptied = cut % 2 ? high : low;
+    whole.join(emptied, true);
+    EXPECT_TRUE(emptied.begin() == emptied.end());
+    EXPECT_LE(whole.height(), static_cast<int>(1.4405 * std::log2(n + 2)));
+    int expected = 0;
+    for (auto it = whole.begin(); it != whole.end(); ++it) {
+      EXPECT_EQ(*it, expected++);
+    }
+    EXPECT_EQ(expected, n);
+    for (int i = 0; i < n; ++i) {
+      EXPECT_EQ(whole.rank(i), static_cast<size_t>(i));
+    }
+  }
+}
+
+TEST(AvlTreeSuite, EraseRangeCountsWithoutSizes) {
+  s21::BinaryTree<int, std::less<int>> my_container;
+  const int n = 500;
+  for (int i = 0; i < n; ++i) my_container.insert((i * 7) % n);
+  EXPECT_EQ(my_container.erase_range(my_container.lower_bound(100),
+                                     my_container.lower_bound(450)),
+            350U);
+  s21::BinaryTree<int, std::less<int>> tail;
+  EXPECT_EQ(my_container.split(my_container.lower_bound(50), tail, 150), 100U);
+  EXPECT_EQ(*tail.begin(), 50);
+  EXPECT_EQ(*--tail.end(), n - 1);
+  EXPECT_EQ(*--my_container.end(), 49);
+  EXPECT_EQ(my_container.erase_range(my_container.begin(),
+                                     my_container.end()),
+            50U);
+  EXPECT_TRUE(my_container.begin() == my_container.end());
+}
+
+TEST(AvlTreeSuite, HintedInsertKeepsOrderAndBalance) {
+  s21::BinaryTree<int, std::less<int>, std::allocator<int>, true> tree;
+  const int n = 2000;
+  for (int i = 0; i < n; i += 2) tree.insert_hint(tree.end(), i, true);
+  // Odd keys with hints that are right, one off, and far off.
+  auto hint = tree.begin();
+  for (int i = 1; i < n; i += 2) {
+    hint = tree.insert_hint(i % 3 ? hint : tree.begin(), i, true).first;
+    ++hint;
+  }
+  auto repeat = tree.insert_hint(tree.find(10), 10, true);
+  EXPECT_FALSE(repeat.second);
+  EXPECT_EQ(*repeat.first, 10);
+  EXPECT_LE(tree.height(), static_cast<int>(1.4405 * std::log2(n + 2)));
+  int expected = 0;
+  for (auto it = tree.begin(); it != tree.end(); ++it) {
+    EXPECT_EQ(*it, expected);
+    EXPECT_EQ(tree.rank(*it), static_cast<size_t>(expected));
+    ++expected;
+  }
+  EXPECT_EQ(expected, n);
+}
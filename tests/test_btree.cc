@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../s21_allocator.h"
+#include "../s21_btree_map.h"
+#include "../s21_btree_multiset.h"
+#include "../s21_btree_set.h"
+
+TEST(BTreeSet, MatchesStdSetUnderChurn) {
+  s21::btree_set<int> set;
+  std::set<int> std_set;
+  std::mt19937 gen(15);
+  std::uniform_int_distribution<int> key(0, 20000);
+  for (int i = 0; i < 200000; ++i) {
+    int value = key(gen);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(set.erase(value), std_set.erase(value));
+    } else {
+      EXPECT_EQ(set.insert(value).second, std_set.insert(value).second);
+    }
+  }
+  ASSERT_EQ(set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), std_set.begin()));
+  EXPECT_TRUE(std::equal(set.rbegin(), set.rend(), std_set.rbegin()));
+  for (int value = -1; value <= 20001; value += 7) {
+    EXPECT_EQ(set.contains(value), std_set.count(value) == 1);
+    auto lower = set.lower_bound(value);
+    auto std_lower = std_set.lower_bound(value);
+    EXPECT_EQ(lower == set.end(), std_lower == std_set.end());
+    if (std_lower != std_set.end()) {
+      EXPECT_EQ(*lower, *std_lower);
+    }
+    auto upper = set.upper_bound(value);
+    auto std_upper = std_set.upper_bound(value);
+    EXPECT_EQ(upper == set.end(), std_upper == std_set.end());
+    if (std_upper != std_set.end()) {
+      EXPECT_EQ(*upper, *std_upper);
+    }
+  }
+}
+
+TEST(BTreeSet, SortedInputFillsNodes) {
+  s21::btree_set<int> ascending;
+  s21::btree_set<int> descending;
+  for (int i = 0; i < 100000; ++i) {
+    ascending.insert(i);
+    descending.insert(100000 - i);
+  }
+  EXPECT_EQ(ascending.size(), 100000U);
+  EXPECT_EQ(*ascending.begin(), 0);
+  EXPECT_EQ(*descending.begin(), 1);
+  EXPECT_EQ(*descending.rbegin(), 100000);
+  while (!ascending.empty()) ascending.erase(ascending.begin());
+  EXPECT_TRUE(ascending.begin() == ascending.end());
+  for (int i = 1; i <= 100000; i += 2) descending.erase(i);
+  EXPECT_EQ(descending.size(), 50000U);
+  int expected = 2;
+  for (int value : descending) {
+    EXPECT_EQ(value, expected);
+    expected += 2;
+  }
+}
+
+TEST(BTreeSet, StringsCopyMoveAndMerge) {
+  s21::btree_set<std::string> set;
+  for (int i = 0; i < 5000; ++i) set.insert(std::to_string(i * 3 % 5000));
+  s21::btree_set<std::string> copy(set);
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), copy.begin(), copy.end()));
+  s21::btree_set<std::string> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 5000U);
+  EXPECT_TRUE(copy.empty());
+  s21::btree_set<std::string> other{"0", "1", "x", "y"};
+  set.merge(other);
+  EXPECT_EQ(set.size(), 5002U);
+  EXPECT_EQ(other.size(), 2U);
+  EXPECT_TRUE(other.contains("0"));
+  EXPECT_TRUE(set.contains("y"));
+  copy = set;
+  EXPECT_EQ(copy.size(), 5002U);
+  set.clear();
+  set.swap(copy);
+  EXPECT_EQ(set.size(), 5002U);
+  EXPECT_TRUE(copy.empty());
+}
+
+TEST(BTreeSet, TransparentComparator) {
+  s21::btree_set<std::string, std::less<>> set{"apple", "pear", "plum"};
+  std::string_view key = "pear";
+  EXPECT_TRUE(set.contains(key));
+  EXPECT_EQ(*set.lower_bound(std::string_view("peach")), "pear");
+  EXPECT_EQ(set.erase(key), 1U);
+  EXPECT_EQ(set.count(key), 0U);
+}
+
+TEST(BTreeMultiset, MatchesStdMultiset) {
+  s21::btree_multiset<int> multiset;
+  std::multiset<int> std_multiset;
+  std::mt19937 gen(16);
+  for (int i = 0; i < 50000; ++i) {
+    int value = static_cast<int>(gen() % 500);
+    multiset.insert(value);
+    std_multiset.insert(value);
+  }
+  for (int value = 0; value < 500; value += 3) {
+    EXPECT_EQ(multiset.count(value), std_multiset.count(value));
+    auto range = multiset.equal_range(value);
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(range.first,
+                                                     range.second)),
+              std_multiset.count(value));
+  }
+  for (int value = 0; value < 500; value += 2) {
+    EXPECT_EQ(multiset.erase(value), std_multiset.erase(value));
+  }
+  ASSERT_EQ(multiset.size(), std_multiset.size());
+  EXPECT_TRUE(std::equal(multiset.begin(), multiset.end(),
+                         std_multiset.begin()));
+  s21::btree_multiset<int> other{1, 1, 2};
+  multiset.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(multiset.count(1), std_multiset.count(1) + 2);
+}
+
+TEST(BTreeMap, MatchesStdMap) {
+  s21::btree_map<int, std::string> map;
+  std::map<int, std::string> std_map;
+  std::mt19937 gen(17);
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(gen() % 10000);
+    std::string value = std::to_string(i);
+    if (gen() % 4 == 0) {
+      EXPECT_EQ(map.erase(key), std_map.erase(key));
+    } else {
+      map[key] = value;
+      std_map[key] = value;
+    }
+  }
+  ASSERT_EQ(map.size(), std_map.size());
+  EXPECT_TRUE(std::equal(map.begin(), map.end(), std_map.begin()));
+  for (auto it = map.begin(); it != map.end(); ++it) it->second += "!";
+  for (const auto &[key, value] : std_map) EXPECT_EQ(map.at(key), value + "!");
+  EXPECT_THROW(map.at(-1), std::out_of_range);
+}
+
+TEST(BTreeMap, Modifiers) {
+  s21::btree_map<int, int> map{{1, 10}, {2, 20}, {3, 30}};
+  EXPECT_FALSE(map.insert(2, 0).second);
+  EXPECT_EQ(map.at(2), 20);
+  EXPECT_FALSE(map.insert_or_assign(2, 21).second);
+  EXPECT_EQ(map.at(2), 21);
+  EXPECT_TRUE(map.emplace(4, 40).second);
+  map.erase(map.find(1));
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.begin()->first, 2);
+  EXPECT_EQ(map.rbegin()->second, 40);
+  EXPECT_EQ(map.lower_bound(3)->second, 30);
+  EXPECT_EQ(map.upper_bound(3)->second, 40);
+  s21::btree_map<int, int> other{{4, 0}, {5, 50}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_EQ(map.at(4), 40);
+  EXPECT_EQ(other.at(4), 0);
+}
+
+namespace {
+// A key that counts its copies; moving it is free.
+struct CountedKey {
+  explicit CountedKey(int k) : key(k) {}
+  CountedKey(const CountedKey &other) : key(other.key) { ++copies; }
+  CountedKey(CountedKey &&other) noexcept = default;
+  CountedKey &operator=(const CountedKey &other) = default;
+  CountedKey &operator=(CountedKey &&other) noexcept = default;
+  bool operator<(const CountedKey &other) const { return key < other.key; }
+
+  int key;
+  static inline int copies = 0;
+};
+}  // namespace
+
+TEST(BTreeMap, RebalancingMovesKeys) {
+  s21::btree_map<CountedKey, int> map;
+  for (int i = 0; i < 5000; ++i) map.emplace(CountedKey(i * 2), i);
+  int copies = CountedKey::copies;
+  for (int i = 0; i < 5000; i += 2) map.erase(CountedKey(i * 2));
+  for (int i = 0; i < 2000; ++i) map.erase(CountedKey(i * 2 + 2));
+  EXPECT_EQ(CountedKey::copies, copies);
+  ASSERT_EQ(map.size(), 1500U);
+  int previous = -1;
+  for (const auto &[key, value] : map) {
+    EXPECT_LT(previous, key.key);
+    EXPECT_EQ(key.key, value * 2);
+    previous = key.key;
+  }
+}
+
+TEST(BTreeSet, ConstTreeHandsOutConstIterators) {
+  using Tree = s21::BTree<int, int, s21::BTreeIdentity, std::less<int>>;
+  Tree tree;
+  tree.insert_unique(1);
+  const Tree &view = tree;
+  static_assert(
+      std::is_same<decltype(view.begin()), Tree::const_iterator>::value);
+  static_assert(
+      std::is_same<decltype(view.cbegin()), Tree::const_iterator>::value);
+  static_assert(
+      std::is_same<decltype(view.find(1)), Tree::const_iterator>::value);
+  static_assert(std::is_same<decltype(*view.lower_bound(1)),
+                             const int &>::value);
+  EXPECT_EQ(*view.find(1), 1);
+  EXPECT_TRUE(view.begin() == tree.begin());
+}
+
+TEST(BTreeAllocator, PoolAllocatorSurvivesMove) {
+  s21::pool_allocator<int> pool;
+  s21::pool_allocator<int> moved(std::move(pool));
+  EXPECT_TRUE(moved == pool);
+  pool = std::move(moved);
+  EXPECT_TRUE(moved == pool);
+
+  using PooledSet =
+      s21::btree_set<int, std::less<int>, s21::pool_allocator<int>>;
+  PooledSet source;
+  source.insert(1);
+  PooledSet target(std::move(source));
+  for (int i = 2; i < 200; ++i) source.insert(i);
+  EXPECT_EQ(source.size(), 198U);
+  EXPECT_TRUE(source.contains(150));
+  EXPECT_EQ(target.size(), 1U);
+  target = std::move(source);
+  source.insert(7);
+  EXPECT_EQ(target.size(), 198U);
+  EXPECT_TRUE(source.contains(7));
+}
+
+TEST(BTreeSet, CopiesKeepStatefulComparator) {
+  struct Ordered {
+    bool descending = false;
+    bool operator()(int a, int b) const { return descending ? b < a : a < b; }
+  };
+  using Tree = s21::BTree<int, int, s21::BTreeIdentity, Ordered>;
+  Tree tree(Ordered{true}, std::allocator<int>());
+  for (int i = 0; i < 100; ++i) tree.insert_unique(i);
+  Tree copy(tree);
+  Tree assigned;
+  assigned = copy;
+  Tree moved;
+  moved = Tree(assigned);
+  for (Tree *t : {&copy, &assigned, &moved}) {
+    t->insert_unique(100);
+    EXPECT_EQ(*t->begin(), 100);
+    EXPECT_EQ(t->size(), 101U);
+    EXPECT_TRUE(std::is_sorted(t->begin(), t->end(), std::greater<int>()));
+  }
+}
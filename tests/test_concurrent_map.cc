@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_concurrent_map.h"
+
+TEST(ConcurrentMap, SingleKeyOperations) {
+  s21::concurrent_map<int, std::string> map(5);
+  EXPECT_EQ(map.shard_count(), 8U);
+  EXPECT_TRUE(map.insert(1, "one"));
+  EXPECT_FALSE(map.insert(1, "uno"));
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_FALSE(map.insert_or_assign(1, "uno"));
+  EXPECT_EQ(map.find(1), std::optional<std::string>("uno"));
+  EXPECT_EQ(map.find(2), std::nullopt);
+  EXPECT_THROW(map.at(2), std::out_of_range);
+  EXPECT_TRUE(map.try_emplace(2, 3, 'x'));
+  EXPECT_TRUE(map.visit(2, [](const std::string &value) {
+    EXPECT_EQ(value, "xxx");
+  }));
+  EXPECT_TRUE(map.update(2, [](std::string &value) { value += "!"; }));
+  EXPECT_FALSE(map.update(3, [](std::string &value) { value += "!"; }));
+  EXPECT_TRUE(map.upsert(3, [](std::string &value) { value += "new"; }));
+  EXPECT_EQ(map.at(3), "new");
+  EXPECT_FALSE(map.erase_if(2, [](const std::string &value) {
+    return value.empty();
+  }));
+  EXPECT_TRUE(map.erase_if(2, [](const std::string &value) {
+    return value == "xxx!";
+  }));
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_EQ(map.count(1), 0U);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(ConcurrentMap, Compute) {
+  s21::concurrent_map<std::string, int> map{{"a", 1}};
+  auto increment = [](const int *current) -> std::optional<int> {
+    return current ? *current + 1 : 1;
+  };
+  map.compute("a", increment);
+  map.compute("b", increment);
+  EXPECT_EQ(map.at("a"), 2);
+  EXPECT_EQ(map.at("b"), 1);
+  map.compute("a", [](const int *) -> std::optional<int> {
+    return std::nullopt;
+  });
+  EXPECT_FALSE(map.contains("a"));
+  int total = 0;
+  map.for_each([&total](const std::string &, int value) { total += value; });
+  EXPECT_EQ(total, 1);
+}
+
+TEST(ConcurrentMap, ParallelWritersDoNotLoseUpdates) {
+  s21::concurrent_map<int, int> map(16);
+  const int threads = 8;
+  const int keys = 1000;
+  const int rounds = 20;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&map, t] {
+      for (int round = 0; round < rounds; ++round) {
+        for (int key = 0; key < keys; ++key) {
+          map.upsert(key, [](int &value) { ++value; });
+        }
+      }
+      for (int key = 0; key < keys; ++key) map.insert(t * keys + keys + key, t);
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(keys + threads * keys));
+  for (int key = 0; key < keys; ++key) {
+    EXPECT_EQ(map.at(key), threads * rounds);
+  }
+  std::size_t visited = 0;
+  map.for_each([&visited](int, int) { ++visited; });
+  EXPECT_EQ(visited, map.size());
+}
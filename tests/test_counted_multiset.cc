@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <set>
+#include <vector>
+
+#include "../s21_counted_multiset.h"
+
+TEST(CountedMultisetConstructor, InitializerList) {
+  s21::counted_multiset<int> multiset{5, 1, 5, 3, 5, 1};
+  std::multiset<int> std_multiset{5, 1, 5, 3, 5, 1};
+  EXPECT_EQ(multiset.size(), std_multiset.size());
+  EXPECT_EQ(multiset.distinct_size(), 3U);
+  auto std_p = std_multiset.begin();
+  for (auto p = multiset.begin(); p != multiset.end(); ++p, ++std_p)
+    EXPECT_EQ(*p, *std_p);
+  EXPECT_TRUE(std_p == std_multiset.end());
+}
+
+TEST(CountedMultisetModifiers, DuplicatesShareOneNode) {
+  s21::counted_multiset<int> multiset;
+  for (int i = 0; i < 100000; ++i) multiset.insert(i % 10);
+  EXPECT_EQ(multiset.size(), 100000U);
+  EXPECT_EQ(multiset.distinct_size(), 10U);
+  EXPECT_EQ(multiset.count(7), 10000U);
+  EXPECT_EQ(multiset.count(10), 0U);
+  EXPECT_EQ(multiset.erase(7), 10000U);
+  EXPECT_EQ(multiset.distinct_size(), 9U);
+  multiset.erase(multiset.find(3));
+  EXPECT_EQ(multiset.count(3), 9999U);
+  EXPECT_EQ(multiset.size(), 89999U);
+}
+
+TEST(CountedMultisetIterator, WalksBothWays) {
+  s21::counted_multiset<int> multiset{2, 2, 4, 4, 4, 6};
+  std::vector<int> backwards;
+  for (auto p = multiset.end(); p != multiset.begin();) {
+    backwards.push_back(*--p);
+  }
+  EXPECT_EQ(backwards, (std::vector<int>{6, 4, 4, 4, 2, 2}));
+  auto range = multiset.equal_range(4);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+  EXPECT_EQ(*range.second, 6);
+  EXPECT_TRUE(multiset.lower_bound(3) == range.first);
+  EXPECT_TRUE(multiset.upper_bound(4) == range.second);
+  auto missing = multiset.equal_range(5);
+  EXPECT_TRUE(missing.first == missing.second);
+}
+
+TEST(CountedMultisetModifiers, EraseLastOccurrenceRemovesKey) {
+  s21::counted_multiset<int> multiset{1, 3, 3};
+  multiset.erase(multiset.find(1));
+  EXPECT_FALSE(multiset.contains(1));
+  EXPECT_EQ(multiset.distinct_size(), 1U);
+  EXPECT_EQ(*multiset.begin(), 3);
+}
+
+TEST(CountedMultisetModifiers, MergeAddsCounts) {
+  s21::counted_multiset<int> multiset1{1, 1, 4};
+  s21::counted_multiset<int> multiset2{1, 9, 9};
+  multiset1.merge(multiset2);
+  EXPECT_TRUE(multiset2.empty());
+  EXPECT_EQ(multiset1.size(), 6U);
+  EXPECT_EQ(multiset1.count(1), 3U);
+  EXPECT_EQ(multiset1.count(9), 2U);
+  s21::counted_multiset<int> copy(multiset1);
+  copy.insert(4, 5);
+  EXPECT_EQ(copy.count(4), 6U);
+  EXPECT_EQ(multiset1.count(4), 1U);
+}
+
+TEST(CountedMultisetIterator, ReverseIteration) {
+  s21::counted_multiset<int> multiset{1, 2, 2};
+  std::vector<int> values(multiset.rbegin(), multiset.rend());
+  EXPECT_EQ(values, (std::vector<int>{2, 2, 1}));
+}
+
+TEST(CountedMultisetModifiers, EraseWhileIterating) {
+  s21::counted_multiset<int> multiset{1, 2, 2, 2, 3, 3, 4};
+  for (auto it = multiset.begin(); it != multiset.end();) {
+    if (*it % 2 == 0) {
+      multiset.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(std::vector<int>(multiset.begin(), multiset.end()),
+            (std::vector<int>{1, 3, 3}));
+  for (auto it = multiset.begin(); it != multiset.end();) {
+    it = *it == 3 ? multiset.erase(it) : std::next(it);
+  }
+  EXPECT_EQ(std::vector<int>(multiset.begin(), multiset.end()),
+            (std::vector<int>{1}));
+  EXPECT_EQ(multiset.size(), 1U);
+  EXPECT_EQ(multiset.distinct_size(), 1U);
+
+  // An iterator further into the run still has the rest of it to visit.
+  multiset.insert(5, 3);
+  auto first = multiset.find(5);
+  auto later = std::next(first);
+  multiset.erase(first);
+  EXPECT_EQ(std::distance(later, multiset.end()), 2);
+  EXPECT_EQ(*later, 5);
+  EXPECT_TRUE(std::prev(later) == multiset.begin());
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_flat_map.h"
+#include "../s21_flat_multiset.h"
+#include "../s21_flat_set.h"
+
+TEST(FlatSet, MatchesStdSet) {
+  s21::flat_set<int> set;
+  std::set<int> std_set;
+  std::mt19937 gen(16);
+  for (int i = 0; i < 5000; ++i) {
+    int value = static_cast<int>(gen() % 2000);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(set.erase(value), std_set.erase(value));
+    } else {
+      EXPECT_EQ(set.insert(value).second, std_set.insert(value).second);
+    }
+  }
+  ASSERT_EQ(set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), std_set.begin()));
+  EXPECT_TRUE(std::equal(set.rbegin(), set.rend(), std_set.rbegin()));
+  for (int value = -1; value <= 2001; value += 5) {
+    EXPECT_EQ(set.contains(value), std_set.count(value) == 1);
+    EXPECT_EQ(set.lower_bound(value) - set.begin(),
+              std::distance(std_set.begin(), std_set.lower_bound(value)));
+    EXPECT_EQ(set.upper_bound(value) - set.begin(),
+              std::distance(std_set.begin(), std_set.upper_bound(value)));
+  }
+}
+
+TEST(FlatSet, BulkInsertMergesAndDropsDuplicates) {
+  s21::flat_set<int> set{9, 1, 5};
+  std::vector<int> more{4, 5, 12, 4, 0, 9};
+  set.insert(more.begin(), more.end());
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{0, 1, 4, 5, 9, 12}));
+  std::vector<int> sorted{2, 3, 3, 7};
+  set.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(std::vector<int>(set.begin(), set.end()),
+            (std::vector<int>{2, 3, 7}));
+  set.erase(set.find(3));
+  EXPECT_EQ(*set.begin(), 2);
+  EXPECT_EQ(*set.rbegin(), 7);
+}
+
+TEST(FlatSet, MergeAndTransparentLookup) {
+  s21::flat_set<std::string, std::less<>> set{"apple", "plum"};
+  s21::flat_set<std::string, std::less<>> other{"pear", "plum"};
+  set.merge(other);
+  EXPECT_EQ(set.size(), 3U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_TRUE(other.contains(std::string_view("plum")));
+  EXPECT_EQ(*set.find(std::string_view("pear")), "pear");
+  EXPECT_EQ(set.erase(std::string_view("apple")), 1U);
+  EXPECT_FALSE(set.contains("apple"));
+}
+
+TEST(FlatMultiset, MatchesStdMultiset) {
+  s21::flat_multiset<int> multiset{3, 1, 3};
+  std::multiset<int> std_multiset{3, 1, 3};
+  std::vector<int> more;
+  std::mt19937 gen(17);
+  for (int i = 0; i < 3000; ++i) more.push_back(static_cast<int>(gen() % 50));
+  multiset.insert(more.begin(), more.end());
+  std_multiset.insert(more.begin(), more.end());
+  for (int i = 0; i < 100; ++i) {
+    multiset.insert(i % 7);
+    std_multiset.insert(i % 7);
+  }
+  for (int value = 0; value < 50; value += 3) {
+    EXPECT_EQ(multiset.count(value), std_multiset.count(value));
+    EXPECT_EQ(multiset.erase(value), std_multiset.erase(value));
+  }
+  ASSERT_EQ(multiset.size(), std_multiset.size());
+  EXPECT_TRUE(std::equal(multiset.begin(), multiset.end(),
+                         std_multiset.begin()));
+  s21::flat_multiset<int> other{1, 1, 100};
+  multiset.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(multiset.count(1), std_multiset.count(1) + 2);
+  EXPECT_EQ(*multiset.rbegin(), 100);
+}
+
+TEST(FlatMap, MatchesStdMap) {
+  s21::flat_map<int, std::string> map;
+  std::map<int, std::string> std_map;
+  std::mt19937 gen(18);
+  for (int i = 0; i < 5000; ++i) {
+    int key = static_cast<int>(gen() % 1000);
+    if (gen() % 4 == 0) {
+      EXPECT_EQ(map.erase(key), std_map.erase(key));
+    } else {
+      map[key] = std::to_string(i);
+      std_map[key] = std::to_string(i);
+    }
+  }
+  ASSERT_EQ(map.size(), std_map.size());
+  auto std_it = std_map.begin();
+  for (auto [key, value] : map) {
+    EXPECT_EQ(key, std_it->first);
+    EXPECT_EQ(value, std_it->second);
+    ++std_it;
+  }
+  for (auto it = map.begin(); it != map.end(); ++it) it->second += "!";
+  for (const auto &[key, value] : std_map) EXPECT_EQ(map.at(key), value + "!");
+  EXPECT_THROW(map.at(-1), std::out_of_range);
+  EXPECT_EQ(map.keys().size(), map.values().size());
+  EXPECT_TRUE(std::is_sorted(map.keys().cbegin(), map.keys().cend()));
+}
+
+TEST(FlatMap, BulkInsertAndModifiers) {
+  s21::flat_map<int, int> map{{3, 30}, {1, 10}, {3, 31}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at(3), 30);
+  std::vector<std::pair<int, int>> more{{5, 50}, {1, 0}, {2, 20}, {5, 51}};
+  map.insert(more.begin(), more.end());
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(map.at(1), 10);
+  EXPECT_EQ(map.at(5), 50);
+  EXPECT_FALSE(map.insert(2, 0).second);
+  EXPECT_FALSE(map.insert_or_assign(2, 21).second);
+  EXPECT_EQ(map.at(2), 21);
+  EXPECT_TRUE(map.emplace(4, 40).second);
+  map.erase(map.find(1));
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.begin()->first, 2);
+  EXPECT_EQ(map.rbegin()->second, 50);
+  EXPECT_EQ((*map.lower_bound(3)).second, 30);
+  EXPECT_EQ(map.upper_bound(3)->first, 4);
+  EXPECT_EQ(map.end() - map.begin(), 4);
+  s21::flat_map<int, int> other{{4, 0}, {6, 60}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 5U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_EQ(map.at(4), 40);
+  EXPECT_EQ(other.at(4), 0);
+}
+
+namespace {
+// Counts its copies.
+struct Tracked {
+  Tracked() = default;
+  explicit Tracked(int v) : value(v) {}
+  Tracked(const Tracked &other) : value(other.value) { ++copies; }
+  Tracked(Tracked &&other) noexcept = default;
+  Tracked &operator=(const Tracked &other) = default;
+  Tracked &operator=(Tracked &&other) noexcept = default;
+  bool operator<(const Tracked &other) const { return value < other.value; }
+
+  int value = 0;
+  static inline int copies = 0;
+};
+}  // namespace
+
+TEST(FlatMap, InsertCopiesOnlyNewKeys) {
+  s21::flat_map<Tracked, Tracked> map;
+  std::pair<const Tracked, Tracked> item(Tracked(1), Tracked(10));
+  EXPECT_TRUE(map.insert(item).second);
+  int copies = Tracked::copies;
+  EXPECT_FALSE(map.insert(item).second);
+  EXPECT_FALSE(map.insert(Tracked(1), Tracked(11)).second);
+  EXPECT_EQ(Tracked::copies, copies);
+  EXPECT_FALSE(map.insert_or_assign(Tracked(1), Tracked(12)).second);
+  EXPECT_EQ(map.at(Tracked(1)).value, 12);
+  EXPECT_TRUE(map.insert(Tracked(2), Tracked(20)).second);
+  EXPECT_EQ(Tracked::copies, copies + 2);
+}
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "../s21_allocator.h"
 #include "../s21_map.h"
 
 class MapTest : public ::testing::Test {
@@ -281,3 +287,282 @@ TEST(MapModifiers, Emplace) {
   find = map.contains(1700);
   EXPECT_TRUE(find);
 }
+
+TEST(MapAllocator, PoolAllocator) {
+  s21::map<int, std::string, s21::MapCompare<std::pair<int, std::string>>,
+           s21::pool_allocator<std::pair<const int, std::string>>>
+      map;
+  for (int i = 0; i < 50; ++i) map.insert(i, std::to_string(i));
+  for (int i = 0; i < 50; i += 3) map.erase(i);
+  EXPECT_EQ(map.at(49), "49");
+  EXPECT_FALSE(map.contains(48));
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  map[5] = "five";
+  EXPECT_EQ(map.at(5), "five");
+}
+
+TEST(MapConstructor, RangeConstructor) {
+  std::vector<std::pair<int, std::string>> items{
+      {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+  s21::map<int, std::string> map(items.begin(), items.end());
+  std::map<int, std::string> std_map(items.begin(), items.end());
+  ASSERT_EQ(map.size(), std_map.size());
+  auto std_p = std_map.begin();
+  for (auto p = map.begin(); p != map.end(); ++p, ++std_p) {
+    EXPECT_EQ((*p).first, std_p->first);
+    EXPECT_EQ((*p).second, std_p->second);
+  }
+  std::vector<std::pair<int, std::string>> sorted{{10, "a"}, {20, "b"}};
+  map.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at(20), "b");
+  EXPECT_FALSE(map.contains(1));
+}
+
+TEST(MapIterator, ReverseIteration) {
+  s21::map<int, char> map{{2, 'b'}, {1, 'a'}, {3, 'c'}};
+  std::string letters;
+  for (auto p = map.rbegin(); p != map.rend(); ++p) letters += p->second;
+  EXPECT_EQ(letters, "cba");
+}
+
+struct CountedValue {
+  CountedValue() { ++constructed; }
+  explicit CountedValue(int value) : value(value) { ++constructed; }
+  CountedValue(const CountedValue& other) : value(other.value) {
+    ++constructed;
+  }
+  CountedValue& operator=(const CountedValue&) = default;
+
+  static inline int constructed = 0;
+  int value = 0;
+};
+
+TEST(MapLookup, KeyLookupsBuildNoElement) {
+  s21::map<std::string, CountedValue> map;
+  map.insert("one", CountedValue(1));
+  map.insert("two", CountedValue(2));
+  CountedValue::constructed = 0;
+  std::string_view two = "two";
+  EXPECT_TRUE(map.contains(two));
+  EXPECT_FALSE(map.contains("three"));
+  EXPECT_EQ(map.count(two), 1U);
+  EXPECT_EQ(map.find(two)->second.value, 2);
+  EXPECT_EQ(map.at("one").value, 1);
+  EXPECT_EQ(map.lower_bound("p")->first, "two");
+  EXPECT_TRUE(map.upper_bound(two) == map.end());
+  EXPECT_EQ(map.erase(two), 1U);
+  EXPECT_EQ(map.size(), 1U);
+  EXPECT_EQ(CountedValue::constructed, 0);
+  EXPECT_THROW(map.at(two), std::out_of_range);
+}
+
+TEST(MapModifiers, SplitJoinAndRanges) {
+  s21::map<int, std::string> map;
+  for (int i = 0; i < 50; ++i) map.insert(i, std::to_string(i));
+  s21::map<int, std::string> shard = map.split(40);
+  EXPECT_EQ(map.size(), 40U);
+  EXPECT_EQ(shard.size(), 10U);
+  EXPECT_EQ(shard.at(45), "45");
+  EXPECT_FALSE(map.contains(45));
+  s21::map<int, std::string> range = map.extract_range(10, 20);
+  EXPECT_EQ(range.size(), 10U);
+  EXPECT_EQ(range.begin()->first, 10);
+  EXPECT_EQ(map.size(), 30U);
+  map.erase(map.begin(), map.find(5));
+  EXPECT_EQ(map.begin()->first, 5);
+  EXPECT_EQ(map.size(), 25U);
+  shard.join(range);
+  EXPECT_EQ(shard.size(), 20U);
+  EXPECT_EQ(shard.begin()->first, 10);
+  EXPECT_THROW(shard.join(map), std::invalid_argument);
+}
+
+TEST(MapModifiers, HintedInsert) {
+  s21::map<int, std::string> map;
+  for (int i = 0; i < 100; ++i) {
+    map.emplace_hint(map.end(), i, std::to_string(i));
+  }
+  auto it = map.insert(map.find(50), {50, "again"});
+  EXPECT_EQ(it->second, "50");
+  it = map.insert(map.begin(), {-1, "-1"});
+  EXPECT_EQ(it, map.begin());
+  it = map.insert(map.begin(), {200, "200"});
+  EXPECT_EQ(std::next(it), map.end());
+  EXPECT_EQ(map.size(), 102U);
+  int expected = -1;
+  for (const auto &value : map) {
+    if (expected == 100) expected = 200;
+    EXPECT_EQ(value.first, expected++);
+  }
+}
+
+namespace {
+// Counts copies of every instance, so tests can check that insertion
+// paths move or construct in place.
+struct CopyCounted {
+  explicit CopyCounted(int v) : value(v) {}
+  CopyCounted(const CopyCounted &other) : value(other.value) { ++copies; }
+  CopyCounted(CopyCounted &&other) noexcept : value(other.value) {}
+  CopyCounted &operator=(const CopyCounted &) = default;
+  int value;
+  static inline int copies = 0;
+};
+}  // namespace
+
+TEST(MapModifiers, EmplaceConstructsInPlace) {
+  s21::map<int, std::unique_ptr<std::string>> map;
+  EXPECT_TRUE(map.try_emplace(1, new std::string("one")).second);
+  auto twice = map.try_emplace(1, nullptr);
+  EXPECT_FALSE(twice.second);
+  EXPECT_EQ(*twice.first->second, "one");
+  auto two = std::make_unique<std::string>("two");
+  EXPECT_TRUE(map.insert({2, std::move(two)}).second);
+  EXPECT_EQ(two, nullptr);
+  auto three = map.emplace_hint(map.end(), 3, std::make_unique<std::string>());
+  EXPECT_EQ(three->first, 3);
+  map.emplace(std::make_pair(4, std::make_unique<std::string>("four")),
+              std::make_pair(1, std::make_unique<std::string>("uno")));
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(*map.at(1), "one");
+  EXPECT_EQ(*map.at(4), "four");
+
+  s21::map<int, CopyCounted> counted;
+  CopyCounted::copies = 0;
+  counted.try_emplace(1, 10);
+  counted.emplace_hint(counted.end(), 2, CopyCounted(20));
+  counted.insert({3, CopyCounted(30)});
+  counted.insert(counted.end(), {4, CopyCounted(40)});
+  counted.emplace(std::make_pair(5, CopyCounted(50)));
+  counted.try_emplace(1, 11);
+  EXPECT_EQ(CopyCounted::copies, 0);
+  EXPECT_EQ(counted.size(), 5U);
+  EXPECT_EQ(counted.at(1).value, 10);
+  EXPECT_EQ(counted.at(5).value, 50);
+}
+
+TEST(MapModifiers, NodeHandlesMoveEntriesBetweenMaps) {
+  s21::map<int, std::string> hot;
+  s21::map<int, std::string> cold;
+  for (int i = 0; i < 10; ++i) hot.insert(i, std::string(100, 'a' + i));
+  const std::string *address = &hot.at(3);
+  auto node = hot.extract(3);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(hot.size(), 9U);
+  EXPECT_FALSE(hot.contains(3));
+  EXPECT_EQ(node.key(), 3);
+  auto result = cold.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_EQ(&result.position->second, address);
+  EXPECT_EQ(cold.size(), 1U);
+
+  // Renaming a key on the way keeps the mapped value where it is.
+  node = hot.extract(hot.find(4));
+  node.key() = 40;
+  node.mapped() += "!";
+  cold.insert(cold.end(), std::move(node));
+  EXPECT_EQ(cold.at(40), std::string(100, 'e') + "!");
+
+  // A clash leaves the node with the caller.
+  hot.insert(5, "other");
+  auto clash = hot.extract(5);
+  clash.key() = 40;
+  result = cold.insert(std::move(clash));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(result.position->first, 40);
+  EXPECT_EQ(result.node.mapped(), std::string(100, 'f'));
+  EXPECT_TRUE(hot.extract(100).empty());
+  EXPECT_FALSE(cold.insert(decltype(hot)::node_type()).inserted);
+  EXPECT_EQ(hot.size(), 7U);
+  EXPECT_EQ(cold.size(), 2U);
+}
+
+TEST(MapAllocator, NodeHandlesAcrossPools) {
+  using Pool = s21::pool_allocator<std::pair<const int, std::string>>;
+  s21::map<int, std::string, s21::MapCompare<std::pair<int, std::string>>,
+           Pool>
+      a;
+  s21::map<int, std::string, s21::MapCompare<std::pair<int, std::string>>,
+           Pool>
+      b;
+  for (int i = 0; i < 20; ++i) a.insert(i, std::to_string(i));
+  for (int i = 0; i < 20; i += 2) b.insert(a.extract(i));
+  a.clear();
+  EXPECT_EQ(b.size(), 10U);
+  EXPECT_EQ(b.at(18), "18");
+}
+
+namespace {
+// Transparent key order that counts its calls.
+struct CountingLess {
+  using is_transparent = void;
+  template <class X, class Y>
+  bool operator()(const X &x, const Y &y) const {
+    ++calls;
+    return s21::MapCompare<std::pair<int, int>>()(x, y);
+  }
+  static inline int calls = 0;
+};
+
+struct DefaultCounted {
+  DefaultCounted() { ++defaults; }
+  explicit DefaultCounted(int v) : value(v) {}
+  int value = 0;
+  static inline int defaults = 0;
+};
+}  // namespace
+
+TEST(MapModifiers, UpsertAndComputeDescendOnce) {
+  s21::map<int, int, CountingLess> map;
+  for (int i = 0; i < 1000; ++i) map.insert(i, 0);
+  CountingLess::calls = 0;
+  map.find(777);
+  int find_calls = CountingLess::calls;
+  CountingLess::calls = 0;
+  EXPECT_EQ(map.upsert(777, [](int &value) { value += 5; }), 5);
+  EXPECT_EQ(CountingLess::calls, find_calls);
+  EXPECT_EQ(map.upsert(2000, [](int &value) { value += 7; }), 7);
+  EXPECT_EQ(map.size(), 1001U);
+
+  // compute can decline a new entry or drop an existing one.
+  auto missing = map.compute(3000, [](int &, bool existed) {
+    return existed;
+  });
+  EXPECT_EQ(missing, map.end());
+  EXPECT_FALSE(map.contains(3000));
+  auto dropped = map.compute(777, [](int &value, bool existed) {
+    return existed && value != 5;
+  });
+  EXPECT_EQ(dropped, map.end());
+  EXPECT_FALSE(map.contains(777));
+  auto kept = map.compute(778, [](int &value, bool) {
+    value = 1;
+    return true;
+  });
+  EXPECT_EQ(kept->second, 1);
+  EXPECT_EQ(map.size(), 1000U);
+  EXPECT_THROW(map.compute(4000,
+                           [](int &, bool) -> bool {
+                             throw std::runtime_error("no");
+                           }),
+               std::runtime_error);
+  EXPECT_EQ(map.size(), 1000U);
+}
+
+TEST(MapModifiers, SubscriptBuildsNothingForPresentKeys) {
+  s21::map<std::string, DefaultCounted> map;
+  map.try_emplace("a", 1);
+  DefaultCounted::defaults = 0;
+  EXPECT_EQ(map["a"].value, 1);
+  EXPECT_EQ(DefaultCounted::defaults, 0);
+  map["b"].value = 2;
+  EXPECT_EQ(DefaultCounted::defaults, 1);
+  std::string key = "c";
+  map[std::move(key)].value = 3;
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at("c").value, 3);
+  EXPECT_FALSE(map.insert_or_assign("c", DefaultCounted(4)).second);
+  EXPECT_EQ(map.at("c").value, 4);
+}
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../s21_multiset.h"
 
@@ -298,3 +304,182 @@ TEST(MultisetModifiers, Emplace) {
   find = ad.contains(133);
   EXPECT_TRUE(find);
 }
+
+TEST(MultisetAllocator, PolymorphicAllocator) {
+  std::pmr::unsynchronized_pool_resource resource;
+  s21::pmr::multiset<int> multiset(&resource);
+  for (int value : {3, 1, 3, 2, 3}) multiset.insert(value);
+  EXPECT_EQ(multiset.size(), 5U);
+  EXPECT_EQ(multiset.count(3), 3U);
+  EXPECT_TRUE(multiset.get_allocator().resource() == &resource);
+}
+
+TEST(MultisetConstructor, CopyKeepsDuplicates) {
+  s21::multiset<int> multiset{5, 1, 5, 3, 5, 1};
+  s21::multiset<int> copy(multiset);
+  s21::multiset<int> assigned{42};
+  assigned = multiset;
+  std::multiset<int> std_multiset{5, 1, 5, 3, 5, 1};
+  auto std_p = std_multiset.begin();
+  auto assigned_p = assigned.begin();
+  for (auto p = copy.begin(); p != copy.end(); ++p, ++std_p, ++assigned_p) {
+    EXPECT_EQ(*p, *std_p);
+    EXPECT_EQ(*assigned_p, *std_p);
+  }
+  EXPECT_TRUE(std_p == std_multiset.end());
+  EXPECT_TRUE(assigned_p == assigned.end());
+  EXPECT_EQ(copy.count(5), 3U);
+}
+
+TEST(MultisetConstructor, RangeConstructor) {
+  std::vector<int> items{4, 2, 4, 1, 2, 4};
+  s21::multiset<int> multiset(items.begin(), items.end());
+  std::multiset<int> std_multiset(items.begin(), items.end());
+  ASSERT_EQ(multiset.size(), std_multiset.size());
+  auto std_p = std_multiset.begin();
+  for (auto p = multiset.begin(); p != multiset.end(); ++p, ++std_p)
+    EXPECT_EQ(*p, *std_p);
+  EXPECT_EQ(multiset.count(4), 3U);
+  std::vector<int> sorted{1, 1, 2};
+  multiset.assign_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(multiset.size(), 3U);
+  EXPECT_EQ(multiset.count(1), 2U);
+}
+
+TEST(MultisetModifiers, MergeEmptiesSource) {
+  s21::multiset<int> multiset1{1, 4, 4, 9};
+  s21::multiset<int> multiset2{4, 0, 9, 9};
+  std::multiset<int> std_multiset1{1, 4, 4, 9};
+  std::multiset<int> std_multiset2{4, 0, 9, 9};
+  multiset1.merge(multiset2);
+  std_multiset1.merge(std_multiset2);
+  EXPECT_TRUE(multiset2.empty());
+  EXPECT_TRUE(multiset2.begin() == multiset2.end());
+  ASSERT_EQ(multiset1.size(), std_multiset1.size());
+  auto std_p = std_multiset1.begin();
+  for (auto p = multiset1.begin(); p != multiset1.end(); ++p, ++std_p)
+    EXPECT_EQ(*p, *std_p);
+  EXPECT_EQ(multiset1.count(9), 3U);
+}
+
+TEST(MultisetLookup, OrderStatistics) {
+  using ranked = s21::multiset<int, std::less<int>, std::allocator<int>, true>;
+  ranked multiset1{5, 1, 3, 3, 3, 8};
+  ranked multiset2{3, 0, 9};
+  multiset1.merge(multiset2);
+  EXPECT_EQ(multiset1.rank(3), 2U);
+  EXPECT_EQ(multiset1.rank(4), 6U);
+  EXPECT_EQ(multiset1.count_range(3, 5), 4U);
+  EXPECT_EQ(*multiset1.select(5), 3);
+  EXPECT_EQ(*multiset1.select(8), 9);
+  multiset1.erase(multiset1.select(2));
+  EXPECT_EQ(multiset1.count_range(3, 4), 3U);
+  EXPECT_EQ(multiset1.end() - multiset1.begin(), 8);
+}
+
+struct AbsLess {
+  bool operator()(int a, int b) const { return std::abs(a) < std::abs(b); }
+};
+
+TEST(MultisetLookup, CountUsesComparator) {
+  s21::multiset<int, AbsLess> multiset;
+  for (int value : {3, -3, 1, 3, -5, 5, 0}) multiset.insert(value);
+  EXPECT_EQ(multiset.count(-3), 3U);
+  EXPECT_EQ(multiset.count(5), 2U);
+  EXPECT_EQ(multiset.count(4), 0U);
+  auto range = multiset.equal_range(3);
+  EXPECT_TRUE(range.first == multiset.lower_bound(3));
+  EXPECT_TRUE(range.second == multiset.upper_bound(3));
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+}
+
+TEST(MultisetModifiers, EraseKeyRemovesAllEqual) {
+  s21::multiset<int> multiset;
+  std::multiset<int> std_multiset;
+  for (int i = 0; i < 200; ++i) {
+    multiset.insert(i % 7);
+    std_multiset.insert(i % 7);
+  }
+  EXPECT_EQ(multiset.erase(3), std_multiset.erase(3));
+  EXPECT_EQ(multiset.erase(3), 0U);
+  EXPECT_EQ(multiset.size(), std_multiset.size());
+  EXPECT_EQ(multiset.count(3), 0U);
+  EXPECT_EQ(multiset.count(4), std_multiset.count(4));
+  auto std_p = std_multiset.begin();
+  for (auto p = multiset.begin(); p != multiset.end(); ++p, ++std_p)
+    EXPECT_EQ(*p, *std_p);
+}
+
+TEST(MultisetModifiers, SplitJoinAndRanges) {
+  s21::multiset<int> multiset;
+  for (int i = 0; i < 90; ++i) multiset.insert(i % 9);
+  s21::multiset<int> upper = multiset.split(5);
+  EXPECT_EQ(multiset.size(), 50U);
+  EXPECT_EQ(upper.size(), 40U);
+  EXPECT_EQ(upper.count(5), 10U);
+  s21::multiset<int> threes = multiset.extract_range(3, 4);
+  EXPECT_EQ(threes.size(), 10U);
+  EXPECT_EQ(multiset.count(3), 0U);
+  EXPECT_THROW(multiset.join(threes), std::invalid_argument);
+  multiset.merge(threes);
+  upper.join(multiset);
+  EXPECT_EQ(upper.size(), 90U);
+  EXPECT_EQ(upper.count(3), 10U);
+  s21::multiset<int> more{8, 8, 9};
+  upper.join(more);
+  EXPECT_EQ(upper.count(8), 12U);
+  auto first = upper.lower_bound(2);
+  std::advance(first, 4);
+  upper.erase(first, upper.upper_bound(6));
+  EXPECT_EQ(upper.count(2), 4U);
+  EXPECT_EQ(upper.count(4), 0U);
+  EXPECT_EQ(upper.size(), 47U);
+}
+
+TEST(MultisetModifiers, HintedInsertGoesBeforeHint) {
+  s21::multiset<int> multiset;
+  std::multiset<int> expected;
+  for (int i = 0; i < 300; ++i) {
+    int value = (i * 37) % 50;
+    auto hint = i % 2 ? multiset.end() : multiset.lower_bound(value);
+    auto it = multiset.insert(hint, value);
+    EXPECT_EQ(*it, value);
+    if (i % 2 == 0) {
+      EXPECT_EQ(std::next(it), hint);
+    }
+    expected.insert(value);
+  }
+  EXPECT_EQ(multiset.size(), expected.size());
+  EXPECT_TRUE(std::equal(multiset.begin(), multiset.end(), expected.begin()));
+  auto it = multiset.emplace_hint(multiset.begin(), -1);
+  EXPECT_EQ(it, multiset.begin());
+  EXPECT_EQ(multiset.size(), 301U);
+}
+
+TEST(MultisetModifiers, EmplaceKeepsDuplicatesAndSize) {
+  s21::multiset<std::string> multiset;
+  multiset.emplace(std::string("b"), "a", std::string(2, 'a'), "b");
+  EXPECT_EQ(multiset.size(), 4U);
+  EXPECT_EQ(multiset.count("b"), 2U);
+  std::string moved = "c";
+  multiset.insert(std::move(moved));
+  multiset.emplace_hint(multiset.end(), 3, 'c');
+  EXPECT_EQ(multiset.size(), 6U);
+  EXPECT_EQ(*std::prev(multiset.end()), "ccc");
+}
+
+TEST(MultisetModifiers, NodeHandles) {
+  s21::multiset<int> from{1, 2, 2, 3};
+  s21::multiset<int> to{2};
+  auto node = from.extract(2);
+  EXPECT_EQ(node.value(), 2);
+  EXPECT_EQ(from.count(2), 1U);
+  EXPECT_TRUE(from.extract(7).empty());
+  auto it = to.insert(std::move(node));
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(to.count(2), 2U);
+  to.insert(to.begin(), from.extract(from.begin()));
+  EXPECT_EQ(*to.begin(), 1);
+  EXPECT_EQ(from.size(), 2U);
+  EXPECT_EQ(to.size(), 3U);
+}
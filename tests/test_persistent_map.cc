@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_persistent_map.h"
+
+TEST(PersistentMap, SnapshotsAreIndependent) {
+  s21::persistent_map<int, std::string> map{{2, "two"}, {1, "one"}};
+  s21::persistent_map<int, std::string> before = map.snapshot();
+  EXPECT_TRUE(map.insert(3, "three"));
+  EXPECT_FALSE(map.insert(3, "drei"));
+  EXPECT_FALSE(map.insert_or_assign(1, "uno"));
+  EXPECT_EQ(map.erase(2), 1U);
+  EXPECT_EQ(map.erase(2), 0U);
+
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at(1), "uno");
+  EXPECT_EQ(map.at(3), "three");
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_THROW(map.at(2), std::out_of_range);
+
+  EXPECT_EQ(before.size(), 2U);
+  EXPECT_EQ(before.at(1), "one");
+  EXPECT_EQ(before.at(2), "two");
+  EXPECT_EQ(before.count(3), 0U);
+
+  std::vector<int> keys;
+  for (const auto &value : before) keys.push_back(value.first);
+  EXPECT_EQ(keys, std::vector<int>({1, 2}));
+  EXPECT_EQ(map.lower_bound(2)->first, 3);
+  EXPECT_EQ(map.upper_bound(1)->first, 3);
+  EXPECT_EQ(map.upper_bound(3), map.end());
+  EXPECT_EQ((++map.find(1))->first, 3);
+}
+
+TEST(PersistentMap, EveryVersionMatchesItsHistory) {
+  std::mt19937 random(7);
+  s21::persistent_map<int, int> map;
+  std::map<int, int> expected;
+  std::vector<s21::persistent_map<int, int>> versions;
+  std::vector<std::map<int, int>> histories;
+  for (int i = 0; i < 4000; ++i) {
+    int key = static_cast<int>(random() % 500);
+    if (random() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      EXPECT_EQ(map.insert_or_assign(key, i),
+                expected.insert_or_assign(key, i).second);
+    }
+    if (i % 100 == 0) {
+      versions.push_back(map.snapshot());
+      histories.push_back(expected);
+    }
+  }
+  versions.push_back(map);
+  histories.push_back(expected);
+  for (std::size_t v = 0; v < versions.size(); ++v) {
+    ASSERT_EQ(versions[v].size(), histories[v].size());
+    auto it = histories[v].begin();
+    for (const auto &value : versions[v]) {
+      EXPECT_EQ(value.first, it->first);
+      EXPECT_EQ(value.second, it->second);
+      ++it;
+    }
+  }
+}
+
+TEST(PersistentMap, StaysBalanced) {
+  s21::PersistentTree<int, int, s21::PersistentIdentity, std::less<int>>
+      tree;
+  const int n = 1 << 14;
+  for (int i = 0; i < n; ++i) tree.insert_unique(i);
+  EXPECT_LE(tree.height(), static_cast<int>(1.45 * std::log2(n + 2)));
+  for (int i = 0; i < n; i += 2) tree.erase_unique(i);
+  EXPECT_EQ(tree.size(), static_cast<std::size_t>(n / 2));
+  EXPECT_LE(tree.height(), static_cast<int>(1.45 * std::log2(n / 2 + 2)));
+}
+
+TEST(PersistentMap, ReadersWalkSnapshotsWhileWriterMutates) {
+  const int keys = 2000;
+  s21::persistent_map<int, int> map;
+  for (int key = 0; key < keys; ++key) map.insert(key, 1);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([keys, snapshot = map.snapshot()] {
+      for (int round = 0; round < 20; ++round) {
+        long long sum = 0;
+        for (const auto &value : snapshot) sum += value.second;
+        EXPECT_EQ(sum, keys);
+      }
+    });
+  }
+  for (int round = 0; round < 10; ++round) {
+    s21::persistent_map<int, int> old = map.snapshot();
+    for (int key = 0; key < keys; key += 3) map.erase(key);
+    for (int key = 0; key < keys; key += 3) map.insert(key, round);
+    EXPECT_EQ(old.size(), map.size());
+  }
+  for (std::thread &reader : readers) reader.join();
+}
+
+TEST(PersistentMap, ReadersTakeSnapshotsWhileWriterMutates) {
+  const int keys = 500;
+  s21::persistent_map<int, int> live;
+  for (int key = 0; key < keys; ++key) live.insert(key, key);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&live, &done] {
+      while (!done) {
+        s21::persistent_map<int, int> snapshot = live.snapshot();
+        std::size_t count = 0;
+        int previous = -1;
+        for (const auto &value : snapshot) {
+          EXPECT_LT(previous, value.first);
+          EXPECT_EQ(value.first, value.second);
+          previous = value.first;
+          ++count;
+        }
+        EXPECT_EQ(count, snapshot.size());
+      }
+    });
+  }
+  for (int round = 0; round < 20; ++round) {
+    for (int key = round % 3; key < keys; key += 3) live.erase(key);
+    for (int key = round % 3; key < keys; key += 3) live.insert(key, key);
+    live.insert_or_assign(round, round);
+  }
+  live.clear();
+  live = s21::persistent_map<int, int>({{1, 1}, {2, 2}});
+  done = true;
+  for (std::thread &reader : readers) reader.join();
+  EXPECT_EQ(live.size(), 2U);
+}
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include "../s21_allocator.h"
 #include "../s21_set.h"
 
 TEST(SetConstructor, DefaultConstructor) {
@@ -634,3 +640,275 @@ TEST(Set, 37_emplace) {
   find = ad.contains(133);
   EXPECT_TRUE(find);
 }
+
+TEST(SetAllocator, PoolAllocator) {
+  s21::set<int, std::less<int>, s21::pool_allocator<int>> a;
+  for (int i = 100; i > 0; --i) a.insert(i);
+  for (int i = 1; i <= 100; i += 2) a.erase(i);
+  for (int i = 1; i <= 100; i += 2) a.insert(i);
+  ASSERT_EQ(a.size(), 100U);
+  int i = 1;
+  for (auto it = a.begin(); it != a.end(); ++it) ASSERT_EQ(*it, i++);
+  s21::set<int, std::less<int>, s21::pool_allocator<int>> b(a);
+  EXPECT_TRUE(a.get_allocator() != b.get_allocator());
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.begin() == a.end());
+  a.insert(7);
+  EXPECT_EQ(*a.begin(), 7);
+  EXPECT_EQ(b.size(), 100U);
+  EXPECT_EQ(*--b.end(), 100);
+}
+
+TEST(SetAllocator, PolymorphicAllocator) {
+  char buffer[4096];
+  std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+  s21::pmr::set<std::string> a(&resource);
+  a.insert("pmr");
+  a.insert("set");
+  a.insert("allocator");
+  EXPECT_TRUE(a.get_allocator().resource() == &resource);
+  EXPECT_TRUE(a.contains("set"));
+  EXPECT_EQ(*a.begin(), "allocator");
+  a.erase("pmr");
+  EXPECT_EQ(a.size(), 2U);
+}
+
+TEST(SetConstructor, RangeConstructor) {
+  std::vector<int> unsorted{5, 3, 9, 3, 1, 5, 7};
+  s21::set<int> s21_s(unsorted.begin(), unsorted.end());
+  std::set<int> std_s(unsorted.begin(), unsorted.end());
+  ASSERT_EQ(s21_s.size(), std_s.size());
+  auto std_p = std_s.begin();
+  for (auto s21_p = s21_s.begin(); s21_p != s21_s.end(); ++s21_p, ++std_p)
+    EXPECT_EQ(*s21_p, *std_p);
+  s21_s.insert(4);
+  EXPECT_TRUE(s21_s.contains(4));
+}
+
+TEST(SetModifiers, AssignSorted) {
+  std::vector<int> sorted;
+  for (int i = 0; i < 1000; ++i) sorted.push_back(i * 2);
+  s21::set<int> s21_s{-1, -2};
+  s21_s.assign_sorted(sorted.begin(), sorted.end());
+  ASSERT_EQ(s21_s.size(), sorted.size());
+  EXPECT_FALSE(s21_s.contains(-1));
+  int expected = 0;
+  for (auto it = s21_s.begin(); it != s21_s.end(); ++it, expected += 2)
+    ASSERT_EQ(*it, expected);
+  EXPECT_EQ(s21_s.erase(500), 1U);
+  EXPECT_EQ(s21_s.size(), sorted.size() - 1);
+  s21_s.assign_sorted(sorted.begin(), sorted.begin());
+  EXPECT_TRUE(s21_s.empty());
+  EXPECT_TRUE(s21_s.begin() == s21_s.end());
+}
+
+namespace {
+// Throws once it has been called budget times.
+struct ThrowingLess {
+  bool operator()(const std::string &x, const std::string &y) const {
+    if (budget >= 0 && budget-- == 0) throw std::runtime_error("compare");
+    return x < y;
+  }
+
+  static inline int budget = -1;
+};
+}  // namespace
+
+TEST(SetModifiers, AssignSortedSurvivesThrowingComparator) {
+  std::vector<std::string> values;
+  for (int i = 0; i < 64; ++i) values.push_back(std::to_string(i * 7 % 20));
+  s21::set<std::string, ThrowingLess> s21_s{"a", "b"};
+  for (int budget = 0;; budget += 5) {
+    ThrowingLess::budget = budget;
+    try {
+      s21_s.assign_sorted(values.begin(), values.end());
+      break;
+    } catch (const std::runtime_error &) {
+      ThrowingLess::budget = -1;
+      ASSERT_EQ(s21_s.size(), 2U);
+      EXPECT_TRUE(s21_s.contains("a"));
+    }
+  }
+  ThrowingLess::budget = -1;
+  EXPECT_EQ(s21_s.size(), 20U);
+}
+
+TEST(SetModifiers, MergeRelinksNodes) {
+  s21::set<int> s21_s1{1, 3, 5, 7, 9, 11, 13, 15};
+  s21::set<int> s21_s2{2, 3, 4};
+  auto moved = s21_s2.find(4);
+  s21_s1.merge(s21_s2);
+  EXPECT_EQ(*moved, 4);
+  EXPECT_EQ(*++moved, 5);
+  EXPECT_EQ(s21_s1.size(), 10U);
+  EXPECT_EQ(s21_s2.size(), 1U);
+  EXPECT_EQ(*s21_s2.begin(), 3);
+}
+
+TEST(SetModifiers, MergeLarge) {
+  s21::set<int> s21_s1;
+  s21::set<int> s21_s2;
+  std::set<int> std_s1;
+  std::set<int> std_s2;
+  for (int i = 0; i < 3000; ++i) {
+    s21_s1.insert(i * 2);
+    std_s1.insert(i * 2);
+    s21_s2.insert(i * 3);
+    std_s2.insert(i * 3);
+  }
+  s21_s1.merge(s21_s2);
+  std_s1.merge(std_s2);
+  ASSERT_EQ(s21_s1.size(), std_s1.size());
+  ASSERT_EQ(s21_s2.size(), std_s2.size());
+  auto std_p = std_s1.begin();
+  for (auto p = s21_s1.begin(); p != s21_s1.end(); ++p, ++std_p)
+    ASSERT_EQ(*p, *std_p);
+  std_p = std_s2.begin();
+  for (auto p = s21_s2.begin(); p != s21_s2.end(); ++p, ++std_p)
+    ASSERT_EQ(*p, *std_p);
+  s21_s2.insert(1);
+  EXPECT_TRUE(s21_s2.contains(1));
+}
+
+TEST(SetModifiers, MergeUnequalAllocators) {
+  s21::set<int, std::less<int>, s21::pool_allocator<int>> a{1, 2, 3};
+  s21::set<int, std::less<int>, s21::pool_allocator<int>> b{3, 4};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 4U);
+  EXPECT_EQ(b.size(), 1U);
+  EXPECT_TRUE(a.contains(4));
+  EXPECT_TRUE(b.contains(3));
+}
+
+TEST(SetIterator, ReverseIteration) {
+  s21::set<int> set{4, 8, 1, 6};
+  std::set<int> std_set{4, 8, 1, 6};
+  auto std_p = std_set.rbegin();
+  for (auto p = set.rbegin(); p != set.rend(); ++p, ++std_p) {
+    EXPECT_EQ(*p, *std_p);
+  }
+  EXPECT_TRUE(std_p == std_set.rend());
+  set.insert(10);
+  set.insert(0);
+  EXPECT_EQ(*set.begin(), 0);
+  EXPECT_EQ(*set.rbegin(), 10);
+  set.erase(10);
+  set.erase(set.begin());
+  EXPECT_EQ(*set.begin(), 1);
+  EXPECT_EQ(*set.rbegin(), 8);
+  const s21::set<int> empty;
+  EXPECT_TRUE(empty.rbegin() == empty.rend());
+}
+
+TEST(SetLookup, TransparentComparator) {
+  s21::set<std::string, std::less<>> set{"apple", "kiwi", "pear"};
+  std::string_view kiwi = "kiwi";
+  EXPECT_TRUE(set.contains(kiwi));
+  EXPECT_EQ(set.count("pear"), 1U);
+  EXPECT_EQ(*set.find(kiwi), "kiwi");
+  EXPECT_EQ(*set.lower_bound("b"), "kiwi");
+  EXPECT_EQ(*set.upper_bound(kiwi), "pear");
+  EXPECT_EQ(set.erase(kiwi), 1U);
+  EXPECT_FALSE(set.contains("kiwi"));
+  EXPECT_EQ(set.size(), 2U);
+}
+
+TEST(SetModifiers, SplitJoinAndRanges) {
+  s21::set<int> set;
+  for (int i = 0; i < 100; ++i) set.insert(i);
+  s21::set<int> upper = set.split(60);
+  EXPECT_EQ(set.size(), 60U);
+  EXPECT_EQ(upper.size(), 40U);
+  EXPECT_EQ(*upper.begin(), 60);
+  EXPECT_EQ(*set.rbegin(), 59);
+
+  s21::set<int> middle = set.extract_range(20, 30);
+  EXPECT_EQ(middle.size(), 10U);
+  EXPECT_EQ(*middle.begin(), 20);
+  EXPECT_EQ(*middle.rbegin(), 29);
+  EXPECT_EQ(set.size(), 50U);
+  EXPECT_FALSE(set.contains(25));
+  EXPECT_TRUE(set.contains(30));
+
+  EXPECT_THROW(set.join(middle), std::invalid_argument);
+  EXPECT_EQ(set.size(), 50U);
+  EXPECT_EQ(middle.size(), 10U);
+  set.merge(middle);
+  upper.join(set);
+  EXPECT_EQ(upper.size(), 100U);
+  EXPECT_TRUE(set.empty());
+  set.swap(upper);
+  int expected = 0;
+  for (int value : set) EXPECT_EQ(value, expected++);
+
+  auto last = set.erase(set.find(10), set.find(90));
+  EXPECT_EQ(*last, 90);
+  EXPECT_EQ(set.size(), 20U);
+  EXPECT_EQ(*--last, 9);
+  EXPECT_TRUE(set.erase(set.begin(), set.end()) == set.end());
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(SetModifiers, HintedInsert) {
+  s21::set<int> set;
+  std::set<int> expected;
+  for (int i = 0; i < 200; ++i) {
+    set.insert(set.end(), i * 2);
+    expected.insert(i * 2);
+  }
+  auto hint = set.begin();
+  for (int i = 0; i < 400; ++i) {
+    // Mostly ascending with some out-of-place keys and repeats.
+    int value = i % 10 == 0 ? 399 - i : i;
+    hint = set.insert(hint, value);
+    EXPECT_EQ(*hint, value);
+    expected.insert(value);
+  }
+  EXPECT_EQ(set.size(), expected.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin()));
+  EXPECT_EQ(*set.emplace_hint(set.end(), 1000), 1000);
+  EXPECT_EQ(*set.emplace_hint(set.end(), 5), 5);
+  EXPECT_EQ(set.size(), expected.size() + 1);
+}
+
+TEST(SetModifiers, MoveOnlyElements) {
+  struct PointeeLess {
+    bool operator()(const std::unique_ptr<int> &a,
+                    const std::unique_ptr<int> &b) const {
+      return *a < *b;
+    }
+  };
+  s21::set<std::unique_ptr<int>, PointeeLess> set;
+  EXPECT_TRUE(set.insert(std::make_unique<int>(2)).second);
+  EXPECT_FALSE(set.insert(std::make_unique<int>(2)).second);
+  EXPECT_EQ(**set.emplace_hint(set.end(), new int(5)), 5);
+  auto added = set.emplace(std::make_unique<int>(1), std::make_unique<int>(5));
+  EXPECT_TRUE(added[0].second);
+  EXPECT_FALSE(added[1].second);
+  set.insert(set.begin(), std::make_unique<int>(0));
+  EXPECT_EQ(set.size(), 4U);
+  int expected[] = {0, 1, 2, 5};
+  int i = 0;
+  for (auto it = set.begin(); it != set.end(); ++it) {
+    EXPECT_EQ(**it, expected[i++]);
+  }
+}
+
+TEST(SetModifiers, NodeHandles) {
+  s21::set<std::string> from{"apple", "banana", "cherry"};
+  s21::set<std::string> to{"banana"};
+  auto node = from.extract("apple");
+  node.value() = "apricot";
+  auto result = to.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(*result.position, "apricot");
+  result = to.insert(from.extract(from.begin()));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(result.node.value(), "banana");
+  EXPECT_EQ(from.size(), 1U);
+  EXPECT_EQ(to.size(), 2U);
+  from.insert(from.end(), std::move(result.node));
+  EXPECT_EQ(from.size(), 2U);
+  EXPECT_EQ(*from.begin(), "banana");
+}
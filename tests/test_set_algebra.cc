@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include "../s21_set_algebra.h"
+
+namespace {
+std::vector<int> RandomKeys(std::mt19937 &random, int count, int range) {
+  std::vector<int> keys;
+  for (int i = 0; i < count; ++i) {
+    keys.push_back(static_cast<int>(random() % range));
+  }
+  return keys;
+}
+
+template <class Set>
+std::vector<int> Elements(const Set &set) {
+  return std::vector<int>(set.begin(), set.end());
+}
+
+// Runs every operation on a and b with each thread count and checks the
+// results against the std algorithms over the same sorted sequences.
+template <class Set>
+void ExpectMatchesStd(const Set &a, const Set &b) {
+  std::vector<int> x = Elements(a);
+  std::vector<int> y = Elements(b);
+  std::vector<int> want_union;
+  std::vector<int> want_intersection;
+  std::vector<int> want_difference;
+  std::vector<int> want_symmetric;
+  std::set_union(x.begin(), x.end(), y.begin(), y.end(),
+                 std::back_inserter(want_union));
+  std::set_intersection(x.begin(), x.end(), y.begin(), y.end(),
+                        std::back_inserter(want_intersection));
+  std::set_difference(x.begin(), x.end(), y.begin(), y.end(),
+                      std::back_inserter(want_difference));
+  std::set_symmetric_difference(x.begin(), x.end(), y.begin(), y.end(),
+                                std::back_inserter(want_symmetric));
+  for (unsigned threads : {1U, 3U, 8U}) {
+    Set got_union = s21::set_union(a, b, threads);
+    Set got_intersection = s21::set_intersection(a, b, threads);
+    Set got_difference = s21::set_difference(a, b, threads);
+    Set got_symmetric = s21::symmetric_difference(a, b, threads);
+    EXPECT_EQ(Elements(got_union), want_union);
+    EXPECT_EQ(got_union.size(), want_union.size());
+    EXPECT_EQ(Elements(got_intersection), want_intersection);
+    EXPECT_EQ(got_intersection.size(), want_intersection.size());
+    EXPECT_EQ(Elements(got_difference), want_difference);
+    EXPECT_EQ(got_difference.size(), want_difference.size());
+    EXPECT_EQ(Elements(got_symmetric), want_symmetric);
+    EXPECT_EQ(got_symmetric.size(), want_symmetric.size());
+  }
+}
+}  // namespace
+
+TEST(SetAlgebra, SetsMatchStdAlgorithms) {
+  std::mt19937 random(21);
+  ExpectMatchesStd(s21::set<int>(), s21::set<int>());
+  for (int small : {0, 1, 10, 300, 5000}) {
+    std::vector<int> x = RandomKeys(random, small, 20000);
+    std::vector<int> y = RandomKeys(random, 5000, 20000);
+    s21::set<int> a(x.begin(), x.end());
+    s21::set<int> b(y.begin(), y.end());
+    ExpectMatchesStd(a, b);
+    ExpectMatchesStd(b, a);
+  }
+}
+
+TEST(SetAlgebra, MultisetsRepeatElementsLikeStd) {
+  std::mt19937 random(42);
+  for (int small : {1, 40, 3000}) {
+    std::vector<int> x = RandomKeys(random, small, 500);
+    std::vector<int> y = RandomKeys(random, 3000, 500);
+    s21::multiset<int> a(x.begin(), x.end());
+    s21::multiset<int> b(y.begin(), y.end());
+    ExpectMatchesStd(a, b);
+    ExpectMatchesStd(b, a);
+  }
+}
+
+TEST(SetAlgebra, OperandsMayBeTheTarget) {
+  s21::set<int> a{1, 2, 3, 4};
+  s21::set<int> b{3, 4, 5};
+  a.assign_set_operation(s21::SetOperation::kUnion, a, b);
+  EXPECT_EQ(Elements(a), std::vector<int>({1, 2, 3, 4, 5}));
+  b.assign_set_operation(s21::SetOperation::kDifference, a, b);
+  EXPECT_EQ(Elements(b), std::vector<int>({1, 2}));
+  a.assign_set_operation(s21::SetOperation::kSymmetricDifference, a, a);
+  EXPECT_TRUE(a.empty());
+  a.insert(7);
+  EXPECT_EQ(Elements(a), std::vector<int>({7}));
+}
+
+TEST(SetAlgebra, ResultsKeepOrderStatisticsAndAllocators) {
+  s21::set<int, std::less<int>, std::allocator<int>, true> evens;
+  s21::set<int, std::less<int>, std::allocator<int>, true> threes;
+  for (int i = 0; i < 3000; i += 2) evens.insert(i);
+  for (int i = 0; i < 3000; i += 3) threes.insert(i);
+  auto both = s21::set_intersection(evens, threes, 4);
+  ASSERT_EQ(both.size(), 500U);
+  EXPECT_EQ(*both.select(100), 600);
+  EXPECT_EQ(both.rank(1200), 200U);
+  EXPECT_EQ(both.count_range(0, 60), 10U);
+
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::set<int> x{std::pmr::polymorphic_allocator<int>(&arena)};
+  s21::pmr::set<int> y{std::pmr::polymorphic_allocator<int>(&arena)};
+  for (int i = 0; i < 100; ++i) x.insert(i);
+  for (int i = 50; i < 150; ++i) y.insert(i);
+  s21::pmr::set<int> all = s21::set_union(x, y, 4);
+  EXPECT_EQ(all.size(), 150U);
+  EXPECT_EQ(all.get_allocator().resource(), &arena);
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../s21_unordered_map.h"
+#include "../s21_unordered_set.h"
+
+namespace {
+struct StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view value) const {
+    return std::hash<std::string_view>()(value);
+  }
+};
+}  // namespace
+
+TEST(UnorderedSet, MatchesStdUnorderedSetUnderChurn) {
+  s21::unordered_set<int> set;
+  std::unordered_set<int> std_set;
+  std::mt19937 gen(17);
+  for (int i = 0; i < 200000; ++i) {
+    int value = static_cast<int>(gen() % 5000);
+    if (gen() % 2 == 0) {
+      EXPECT_EQ(set.erase(value), std_set.erase(value));
+    } else {
+      EXPECT_EQ(set.insert(value).second, std_set.insert(value).second);
+    }
+  }
+  ASSERT_EQ(set.size(), std_set.size());
+  std::size_t visited = 0;
+  for (int value : set) {
+    EXPECT_EQ(std_set.count(value), 1U);
+    ++visited;
+  }
+  EXPECT_EQ(visited, std_set.size());
+  for (int value = -10; value < 5010; ++value) {
+    EXPECT_EQ(set.contains(value), std_set.count(value) == 1);
+  }
+  EXPECT_LE(set.load_factor(), set.max_load_factor());
+}
+
+TEST(UnorderedSet, HashPolicy) {
+  s21::unordered_set<int> set;
+  EXPECT_EQ(set.bucket_count(), 0U);
+  EXPECT_TRUE(set.begin() == set.end());
+  EXPECT_FALSE(set.contains(1));
+  set.reserve(1000);
+  std::size_t buckets = set.bucket_count();
+  EXPECT_GE(buckets * set.max_load_factor(), 1000U);
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  EXPECT_EQ(set.bucket_count(), buckets);
+  set.max_load_factor(0.25f);
+  EXPECT_LE(set.load_factor(), 0.25f);
+  EXPECT_THROW(set.max_load_factor(0.0f), std::invalid_argument);
+  for (int i = 0; i < 1000; i += 2) set.erase(set.find(i));
+  set.rehash(0);
+  EXPECT_EQ(set.size(), 500U);
+  EXPECT_TRUE(set.contains(999));
+  EXPECT_FALSE(set.contains(998));
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.begin() == set.end());
+}
+
+TEST(UnorderedSet, StringsCopyMoveAndMerge) {
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> set;
+  for (int i = 0; i < 3000; ++i) set.insert(std::to_string(i));
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> copy(set);
+  EXPECT_EQ(copy.size(), 3000U);
+  EXPECT_TRUE(copy.contains(std::string_view("2999")));
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> moved(
+      std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.erase(std::string_view("0")), 1U);
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> other{
+      "0", "1", "x"};
+  moved.merge(other);
+  EXPECT_EQ(moved.size(), 3001U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_TRUE(other.contains("1"));
+  copy = moved;
+  EXPECT_EQ(copy.count("x"), 1U);
+}
+
+TEST(UnorderedMap, MatchesStdUnorderedMap) {
+  s21::unordered_map<int, std::string> map;
+  std::unordered_map<int, std::string> std_map;
+  std::mt19937 gen(18);
+  for (int i = 0; i < 100000; ++i) {
+    int key = static_cast<int>(gen() % 3000);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), std_map.erase(key));
+    } else {
+      map[key] = std::to_string(i);
+      std_map[key] = std::to_string(i);
+    }
+  }
+  ASSERT_EQ(map.size(), std_map.size());
+  for (auto &[key, value] : map) EXPECT_EQ(value, std_map.at(key));
+  for (const auto &[key, value] : std_map) EXPECT_EQ(map.at(key), value);
+  EXPECT_THROW(map.at(-1), std::out_of_range);
+}
+
+TEST(UnorderedMap, Modifiers) {
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> map{
+      {"one", 1}, {"two", 2}};
+  EXPECT_FALSE(map.insert("one", 0).second);
+  EXPECT_FALSE(map.insert_or_assign("one", 10).second);
+  EXPECT_EQ(map.at(std::string_view("one")), 10);
+  EXPECT_TRUE(map.try_emplace("three", 3).second);
+  EXPECT_FALSE(map.try_emplace("three", 30).second);
+  EXPECT_EQ(map["three"], 3);
+  EXPECT_TRUE(map.emplace("four", 4).second);
+  map.erase(map.find(std::string_view("two")));
+  EXPECT_FALSE(map.contains("two"));
+  EXPECT_EQ(map.size(), 3U);
+  s21::unordered_map<std::string, int, StringHash, std::equal_to<>> other{
+      {"four", 0}, {"five", 5}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(map.at("four"), 4);
+  EXPECT_EQ(other.at("four"), 0);
+  EXPECT_FALSE(other.contains("five"));
+}
+
+TEST(UnorderedMap, ArgumentsMayReferIntoTheTable) {
+  s21::unordered_map<int, std::string> map;
+  map.try_emplace(0, std::string(100, 'x'));
+  for (int i = 1; i < 200; ++i) map.try_emplace(i, map.at(0));
+  for (int i = 200; i < 400; ++i) map.insert(i, map.at(i - 200));
+  for (int i = 400; i < 800; ++i) map.insert_or_assign(i, map.at(i - 400));
+  ASSERT_EQ(map.size(), 800U);
+  for (int i = 0; i < 800; ++i) EXPECT_EQ(map.at(i), std::string(100, 'x'));
+}
+
+namespace {
+// Counts its copies; a copy throws once the budget it is armed with runs
+// out. The move is not noexcept, so a rehash must copy it.
+struct Fragile {
+  explicit Fragile(int v) : value(v) {}
+  Fragile(const Fragile &other) : value(other.value) {
+    ++copies;
+    if (budget >= 0 && budget-- == 0) throw std::runtime_error("copy");
+  }
+  Fragile(Fragile &&other) : value(other.value) {}
+  Fragile &operator=(const Fragile &other) = default;
+  bool operator==(const Fragile &other) const { return value == other.value; }
+
+  int value;
+  static inline int copies = 0;
+  static inline int budget = -1;
+};
+
+struct FragileHash {
+  std::size_t operator()(const Fragile &key) const noexcept {
+    return std::hash<int>()(key.value);
+  }
+};
+
+// Same key, but moving it cannot throw.
+struct MovableKey {
+  explicit MovableKey(int v) : value(v) {}
+  MovableKey(const MovableKey &other) : value(other.value) { ++copies; }
+  MovableKey(MovableKey &&other) noexcept = default;
+  MovableKey &operator=(const MovableKey &other) = default;
+  bool operator==(const MovableKey &other) const {
+    return value == other.value;
+  }
+
+  int value;
+  static inline int copies = 0;
+};
+
+struct MovableKeyHash {
+  std::size_t operator()(const MovableKey &key) const noexcept {
+    return std::hash<int>()(key.value);
+  }
+};
+}  // namespace
+
+TEST(UnorderedMap, RehashMovesKeys) {
+  s21::unordered_map<MovableKey, int, MovableKeyHash> map;
+  for (int i = 0; i < 100; ++i) map.emplace(MovableKey(i), i);
+  int copies = MovableKey::copies;
+  map.reserve(10000);
+  map.rehash(0);
+  EXPECT_EQ(MovableKey::copies, copies);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(map.at(MovableKey(i)), i);
+}
+
+TEST(UnorderedSet, ThrowingRehashLeavesTableIntact) {
+  s21::unordered_set<Fragile, FragileHash> set;
+  for (int i = 0; i < 50; ++i) set.insert(Fragile(i));
+  std::size_t buckets = set.bucket_count();
+  Fragile::budget = 20;
+  EXPECT_THROW(set.reserve(10000), std::runtime_error);
+  Fragile::budget = -1;
+  EXPECT_EQ(set.bucket_count(), buckets);
+  ASSERT_EQ(set.size(), 50U);
+  for (int i = 0; i < 50; ++i) EXPECT_TRUE(set.contains(Fragile(i)));
+  set.reserve(10000);
+  for (int i = 0; i < 50; ++i) EXPECT_TRUE(set.contains(Fragile(i)));
+}
+
+TEST(UnorderedMap, ConstAccessIsReadOnly) {
+  s21::unordered_map<int, std::string> map;
+  map.insert(1, "one");
+  const auto &view = map;
+  using Map = s21::unordered_map<int, std::string>;
+  static_assert(std::is_same<decltype(view.at(1)), const std::string &>::value);
+  static_assert(
+      std::is_same<decltype(view.find(1)), Map::const_iterator>::value);
+  static_assert(
+      std::is_same<decltype(view.begin()), Map::const_iterator>::value);
+  EXPECT_EQ(view.at(1), "one");
+  EXPECT_THROW(view.at(2), std::out_of_range);
+  EXPECT_TRUE(view.find(1) == map.find(1));
+}